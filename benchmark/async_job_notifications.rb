@@ -0,0 +1,88 @@
+# frozen_string_literal: true
+
+require "roby"
+require "roby/interface/async"
+require "benchmark"
+
+# Replays a burst of job notifications through
+# Roby::Interface::Async::Interface#process_message_queues, as would be
+# received by a UI that registered many job monitors and new job listeners
+JOB_COUNT = 2000
+ACTION_COUNT = 20
+ACTION_LISTENER_COUNT = 200
+ALL_JOBS_LISTENER_COUNT = 100
+MONITOR_COUNT = 300
+
+ActionModel = Struct.new :name
+JobTask = Struct.new :action_model
+
+# Stand-in for Roby::Interface::Client, which only provides the message queues
+# and the job information
+class ReplayClient
+    attr_reader :notification_queue, :ui_event_queue,
+                :job_progress_queue, :exception_queue
+
+    def initialize(job_info)
+        @job_info = job_info
+        @notification_queue = []
+        @ui_event_queue = []
+        @job_progress_queue = []
+        @exception_queue = []
+    end
+
+    def find_job_info_by_id(job_id)
+        @job_info[job_id]
+    end
+
+    # Queues the progress notifications of all jobs, from their creation to
+    # their finalization, as well as one exception per job
+    def queue_burst(job_ids)
+        states = [Roby::Interface::JOB_MONITORED, Roby::Interface::JOB_READY,
+                  Roby::Interface::JOB_STARTED, Roby::Interface::JOB_SUCCESS,
+                  Roby::Interface::JOB_FINALIZED]
+        states.each do |state|
+            job_ids.each do |job_id|
+                _, placeholder_task, task = @job_info[job_id]
+                args = [state, job_id, "job"]
+                args.concat([placeholder_task, task]) if state == Roby::Interface::JOB_MONITORED
+                job_progress_queue << [0, args]
+            end
+        end
+        job_ids.each do |job_id|
+            exception_queue << [0, [:fatal, "exception", [], [job_id]]]
+        end
+    end
+end
+
+def create_interface
+    job_info = (1..JOB_COUNT).each_with_object({}) do |job_id, h|
+        task = JobTask.new(ActionModel.new("action_#{job_id % ACTION_COUNT}"))
+        h[job_id] = [Roby::Interface::JOB_READY, task, task]
+    end
+    client = ReplayClient.new(job_info)
+
+    interface = Roby::Interface::Async::Interface.new(connect: false)
+    interface.instance_variable_set :@client, client
+    ACTION_LISTENER_COUNT.times do |i|
+        interface.on_job(action_name: "action_#{i % ACTION_COUNT}", jobs: []) {}
+    end
+    ALL_JOBS_LISTENER_COUNT.times do
+        interface.on_job(jobs: []) {}
+    end
+    MONITOR_COUNT.times do |i|
+        job_id = i * JOB_COUNT / MONITOR_COUNT + 1
+        Roby::Interface::Async::JobMonitor.new(interface, job_id).start
+    end
+
+    client.queue_burst((1..JOB_COUNT).to_a)
+    interface
+end
+
+Benchmark.bm(40) do |x|
+    interface = create_interface
+    progress_count = interface.client.job_progress_queue.size
+    exception_count = interface.client.exception_queue.size
+    x.report("#{progress_count} job notifications, #{exception_count} exceptions") do
+        interface.process_message_queues
+    end
+end
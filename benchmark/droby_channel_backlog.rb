@@ -0,0 +1,45 @@
+# frozen_string_literal: true
+
+require "roby"
+require "roby/interface"
+require "benchmark"
+require "socket"
+
+# Measures the cost of queueing notifications on a droby channel whose peer is
+# not reading, and of flushing the backlog once the peer reads again
+PACKET_COUNTS = [1_000, 10_000, 50_000].freeze
+PACKET = ("x" * 256).freeze
+
+def fill_socket(io)
+    loop do
+        break if io.write_nonblock("0" * 4096, exception: false) == :wait_writable
+    end
+end
+
+def drain(io)
+    loop do
+        break if io.read_nonblock(1024**2, exception: false) == :wait_readable
+    end
+end
+
+Benchmark.bm(40) do |x|
+    PACKET_COUNTS.each do |count|
+        io_r, io_w = Socket.pair(:UNIX, :STREAM, 0)
+        channel = Roby::Interface::DRobyChannel.new(
+            io_w, false, max_write_buffer_size: 1024**3
+        )
+        fill_socket(io_w)
+
+        x.report("queue #{count} packets") do
+            count.times { channel.push_write_data(PACKET) }
+        end
+        x.report("flush #{count} packets") do
+            until channel.write_buffer_size == 0
+                drain(io_r)
+                channel.push_write_data
+            end
+        end
+        io_r.close
+        io_w.close
+    end
+end
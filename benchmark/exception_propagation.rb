@@ -0,0 +1,41 @@
+# frozen_string_literal: true
+
+require "roby"
+require "benchmark"
+
+# Measures the cost of the traces of exceptions propagated through a deep
+# dependency tree with forks and merges
+DEPTH = 1000
+WIDTH = 4
+COUNT = 100
+
+def propagate_through_tree(origin)
+    e = Roby::ExecutionException.new(Roby::LocalizedError.new(origin))
+    current = origin
+    DEPTH.times do
+        children = Array.new(WIDTH) { Object.new }
+        siblings = children.map do |child|
+            s = e.fork
+            s.propagate(current, child)
+            s
+        end
+        e = siblings.inject { |a, b| a.merge(b) }
+        current = Object.new
+        children.each { |child| e.propagate(child, current) }
+    end
+    e
+end
+
+plan = Roby::ExecutablePlan.new
+plan.add(origin = Roby::Task.new)
+
+Benchmark.bm(50) do |x|
+    x.report("#{COUNT} propagations, depth #{DEPTH}, width #{WIDTH}") do
+        COUNT.times { propagate_through_tree(origin) }
+    end
+
+    e = propagate_through_tree(origin)
+    x.report("#{COUNT} involved task lookups") do
+        COUNT.times { e.dup.involved_task?(origin) }
+    end
+end
@@ -0,0 +1,36 @@
+# frozen_string_literal: true
+
+require "roby"
+require "minitest"
+require "roby/test/execution_expectations"
+require "benchmark"
+
+# Measures the cost of an expect_execution that spans many cycles, with events
+# emitted at each cycle
+CYCLE_COUNTS = [1_000, 10_000].freeze
+
+def run_expectations(plan, cycle_count)
+    plan.add_permanent_event(emitted = Roby::EventGenerator.new)
+    plan.add_permanent_event(not_emitted = Roby::EventGenerator.new)
+
+    cycles = 0
+    expectations = Roby::Test::ExecutionExpectations.new(nil, plan)
+    expectations.timeout(600)
+    expectations.poll { emitted.emit }
+    expectations.parse do
+        achieve { (cycles += 1) >= cycle_count }
+        emit emitted
+        not_emit not_emitted
+    end
+    expectations.verify
+    plan.clear
+end
+
+Benchmark.bm(40) do |x|
+    CYCLE_COUNTS.each do |count|
+        plan = Roby::ExecutablePlan.new
+        x.report("expect_execution over #{count} cycles") do
+            run_expectations(plan, count)
+        end
+    end
+end
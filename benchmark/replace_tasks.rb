@@ -0,0 +1,35 @@
+# frozen_string_literal: true
+
+require "roby"
+require "benchmark"
+
+# Compares replacing N tasks with one Plan#replace_task call per task against
+# a single Plan#replace_tasks call. Each replaced task has a parent and a child
+REPLACEMENT_COUNTS = [100, 1000].freeze
+
+def create_plan(count)
+    plan = Roby::ExecutablePlan.new
+    mappings = {}
+    count.times do
+        plan.add(parent = Roby::Tasks::Simple.new)
+        parent.depends_on(replaced = Roby::Tasks::Simple.new)
+        replaced.depends_on(Roby::Tasks::Simple.new)
+        plan.add(replacing = Roby::Tasks::Simple.new)
+        mappings[replaced] = replacing
+    end
+    [plan, mappings]
+end
+
+Benchmark.bm(40) do |x|
+    REPLACEMENT_COUNTS.each do |count|
+        plan, mappings = create_plan(count)
+        x.report("#{count} calls to #replace_task") do
+            mappings.each { |from, to| plan.replace_task(from, to) }
+        end
+
+        plan, mappings = create_plan(count)
+        x.report("#replace_tasks with #{count} tasks") do
+            plan.replace_tasks(mappings)
+        end
+    end
+end
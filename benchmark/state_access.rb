@@ -0,0 +1,36 @@
+# frozen_string_literal: true
+
+require "roby"
+require "benchmark"
+
+# Measures the throughput of reads and writes of state fields, for fields that
+# are declared in the state model and for free-form fields
+COUNT = 1_000_000
+
+model = Roby::StateModel.new
+model.pose.position = Numeric
+model.pose.orientation = Numeric
+
+state = Roby::StateSpace.new(model)
+state.pose.position = 0
+state.pose.orientation = 0
+free = Roby::StateSpace.new
+free.pose.value = 0
+
+Benchmark.bm(40) do |x|
+    x.report("#{COUNT} reads of a declared field") do
+        COUNT.times { state.pose.position }
+    end
+    x.report("#{COUNT} writes of a declared field") do
+        COUNT.times { |i| state.pose.position = i }
+    end
+    x.report("#{COUNT} reads of a free-form field") do
+        COUNT.times { free.pose.value }
+    end
+    x.report("#{COUNT} writes of a free-form field") do
+        COUNT.times { |i| free.pose.value = i }
+    end
+    x.report("#{COUNT} reads with #get") do
+        COUNT.times { state.get(:pose).get(:position) }
+    end
+end
@@ -0,0 +1,55 @@
+# frozen_string_literal: true
+
+require "roby"
+require "benchmark"
+require "objspace"
+
+# Measures the cost of creating tasks, in time and in memory. Every task
+# creates all the event generators of its model, even though most of them are
+# never emitted, connected or queried, so this is dominated by the per-event
+# allocations
+COUNT = 10_000
+
+task_m = Roby::Task.new_submodel do
+    terminates
+    event :custom
+    forward custom: :success
+end
+
+# Make sure the model templates are computed before measuring
+Roby::Task.new
+task_m.new
+
+def measure_memory(count)
+    GC.start
+    GC.disable
+    before_objects = GC.stat(:total_allocated_objects)
+    before_size = ObjectSpace.memsize_of_all
+    tasks = Array.new(count) { yield }
+    objects = GC.stat(:total_allocated_objects) - before_objects
+    size = ObjectSpace.memsize_of_all - before_size
+    puts format("  %<objects>.1f objects and %<size>.0f bytes per task",
+                objects: Float(objects) / count, size: Float(size) / count)
+    tasks
+ensure
+    GC.enable
+end
+
+Benchmark.bm(40) do |x|
+    x.report("creates #{COUNT} Roby::Task") do
+        COUNT.times { Roby::Task.new }
+    end
+    x.report("creates #{COUNT} tasks with custom events") do
+        COUNT.times { task_m.new }
+    end
+
+    plan = Roby::ExecutablePlan.new
+    x.report("creates and adds #{COUNT} tasks to a plan") do
+        COUNT.times { plan.add(task_m.new) }
+    end
+end
+
+puts "Roby::Task"
+measure_memory(COUNT) { Roby::Task.new }
+puts "Task with custom events"
+measure_memory(COUNT) { task_m.new }
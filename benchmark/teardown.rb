@@ -0,0 +1,55 @@
+# frozen_string_literal: true
+
+require "roby"
+require "benchmark"
+
+# Measures the time and the number of cycles needed by ExecutionEngine#clear to
+# tear down a plan of 20k tasks. Each root has running children, which
+# themselves have a chain of pending tasks
+#
+# The teardown is done for two chain lengths with the same number of tasks.
+# The benchmark fails if they do not need the same number of cycles, as the
+# removal of the pending chains should not depend on their length.
+ROOT_COUNT = 200
+CHILD_COUNT = 9
+CHAIN_LENGTHS = [10, 40].freeze
+
+def create_plan(root_count, chain_length)
+    plan = Roby::ExecutablePlan.new
+    running = []
+    root_count.times do
+        plan.add_mission_task(root = Roby::Tasks::Simple.new)
+        running << root
+        CHILD_COUNT.times do
+            root.depends_on(child = Roby::Tasks::Simple.new)
+            running << child
+            chain_length.times.inject(child) do |parent, _|
+                parent.depends_on(task = Roby::Tasks::Simple.new)
+                task
+            end
+        end
+    end
+    plan.execution_engine.process_events { running.each(&:start!) }
+    plan
+end
+
+cycles = []
+Benchmark.bm(40) do |x|
+    CHAIN_LENGTHS.each do |chain_length|
+        root_count = ROOT_COUNT * CHAIN_LENGTHS.first / chain_length
+        plan = create_plan(root_count, chain_length)
+        engine = plan.execution_engine
+        task_count = plan.num_tasks
+        x.report("teardown of #{task_count} tasks, chains of #{chain_length}") do
+            engine.quit
+            engine.process_events while engine.clear
+        end
+        puts engine.last_teardown_statistics
+        cycles << engine.last_teardown_statistics.cycles
+    end
+end
+
+if cycles.uniq.size != 1
+    raise "teardown cycle count depends on the chain length: "\
+          "#{CHAIN_LENGTHS.zip(cycles).map { |l, c| "#{c} cycles for #{l}" }.join(', ')}"
+end
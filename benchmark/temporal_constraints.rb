@@ -0,0 +1,39 @@
+# frozen_string_literal: true
+
+require "roby"
+require "benchmark"
+
+# Measures the cost of checking temporal and occurence constraints as the
+# history of the constraining event grows
+HISTORY_SIZES = [1_000, 10_000, 100_000].freeze
+CHECKS = 1000
+
+def create_constrained_events(history_size)
+    plan = Roby::ExecutablePlan.new
+    plan.add(parent = Roby::EventGenerator.new)
+    plan.add(child = Roby::EventGenerator.new)
+    parent.add_temporal_constraint(child, 0, history_size + 10)
+    parent.add_occurence_constraint(child, 1, Infinity, true)
+
+    base_time = Time.now - history_size
+    history_size.times do |i|
+        parent.history << Roby::Event.new(parent, i, [], base_time + i)
+    end
+    child.history << Roby::Event.new(child, 0, [], base_time + history_size / 2)
+    child.history << Roby::Event.new(child, 1, [], Time.now)
+    [parent, child]
+end
+
+Benchmark.bm(50) do |x|
+    HISTORY_SIZES.each do |size|
+        _, child = create_constrained_events(size)
+        now = Time.now
+
+        x.report("#{CHECKS} temporal checks, #{size} emissions") do
+            CHECKS.times { child.find_failed_temporal_constraint(now) }
+        end
+        x.report("#{CHECKS} occurence checks, #{size} emissions") do
+            CHECKS.times { child.find_failed_occurence_constraint(false) }
+        end
+    end
+end
@@ -0,0 +1,43 @@
+# frozen_string_literal: true
+
+require "roby"
+require "roby/schedulers/temporal"
+require "benchmark"
+
+# Measures the cost of a scheduling pass of the temporal scheduler on pending
+# tasks related by schedule_as constraints. All tasks are held by a temporal
+# constraint, so that they are all evaluated at each pass.
+TASK_COUNT = 1000
+PASSES = 10
+
+def create_plan
+    plan = Roby::ExecutablePlan.new
+    plan.add(blocker = Roby::EventGenerator.new(true))
+    tasks = Array.new(TASK_COUNT) { Roby::Tasks::Simple.new }
+    tasks.each { |t| plan.add(t) }
+    [plan, blocker, tasks]
+end
+
+def create_chain
+    plan, blocker, tasks = create_plan
+    tasks.each_cons(2) { |child, parent| child.schedule_as(parent) }
+    tasks.last.should_start_after(blocker)
+    plan
+end
+
+def create_fan_in
+    plan, blocker, tasks = create_plan
+    parent = tasks.shift
+    tasks.each { |child| child.schedule_as(parent) }
+    parent.should_start_after(blocker)
+    plan
+end
+
+Benchmark.bm(40) do |x|
+    { "chain" => create_chain, "fan-in" => create_fan_in }.each do |name, plan|
+        scheduler = Roby::Schedulers::Temporal.new(true, true, plan)
+        x.report("#{PASSES} passes, #{TASK_COUNT} tasks #{name}") do
+            PASSES.times { scheduler.initial_events }
+        end
+    end
+end
@@ -0,0 +1,40 @@
+# frozen_string_literal: true
+
+require "roby"
+require "benchmark"
+
+# Measures the cost of computing the free events that are kept by the garbage
+# collection, on plans with large clusters of free events. Half of the
+# clusters are connected to a task.
+CLUSTER_SIZE = 100
+CLUSTER_COUNTS = [10, 50].freeze
+COUNT = 10
+
+def create_plan(cluster_count)
+    plan = Roby::ExecutablePlan.new
+    cluster_count.times do |i|
+        events = Array.new(CLUSTER_SIZE) { Roby::EventGenerator.new(true) }
+        events.each { |ev| plan.add(ev) }
+        events.each_cons(2) { |a, b| a.forward_to b }
+        # Add some combinators, which are connected to several events
+        events.each_slice(10) do |slice|
+            plan.add(or_ev = Roby::OrGenerator.new)
+            slice.each { |ev| ev.signals or_ev }
+        end
+
+        if i.even?
+            plan.add(task = Roby::Task.new)
+            events.last.forward_to task.start_event
+        end
+    end
+    plan
+end
+
+Benchmark.bm(50) do |x|
+    CLUSTER_COUNTS.each do |count|
+        plan = create_plan(count)
+        x.report("#{COUNT} passes, #{count} clusters of #{CLUSTER_SIZE} events") do
+            COUNT.times { plan.useful_events }
+        end
+    end
+end
@@ -54,12 +54,15 @@ class Task < PlanObject; end
 require "roby/droby/event_logging"
 
 require "roby/support"
+require "roby/async_logger"
 require "roby/disposable"
 require "roby/promise"
 require "roby/hooks"
 require "roby/distributed_object"
 require "roby/standard_errors"
+require "roby/exception_trace"
 require "roby/exceptions"
+require "roby/exception_handler_index"
 
 require "roby/relations"
 require "roby/plan"
@@ -79,6 +82,7 @@ class Task < PlanObject; end
 require "roby/event_structure/temporal_constraints"
 
 require "roby/queries"
+require "roby/event_provenance"
 require "roby/event"
 require "roby/filter_generator"
 require "roby/and_generator"
@@ -114,6 +118,7 @@ class Task < PlanObject; end
 
 require "roby/decision_control"
 require "roby/schedulers/null"
+require "roby/poll_scheduler"
 require "roby/execution_engine"
 begin
     require "gctools/oobgc"
@@ -130,6 +135,7 @@ class Task < PlanObject; end
 require "roby/coordination"
 
 require "roby/droby/enable"
+require "roby/plan_checkpoint"
 require "roby/custom_require"
 
 module Roby
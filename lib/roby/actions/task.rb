@@ -15,7 +15,14 @@ class Task < Roby::Task
             attr_reader :transaction
 
             # The planner result. It is either an exception or a task object
-            attr_reader :result
+            #
+            # When the planning task has been restored finished from a
+            # {PlanCheckpoint}, it is the task it plans
+            def result
+                return @result if @result
+
+                planned_tasks.first if success?
+            end
 
             # The action itself
             # @return [Models::Action]
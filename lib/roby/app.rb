@@ -12,6 +12,7 @@
 require "yaml"
 require "utilrb/pathname/find_matching_parent"
 require "roby/app/base"
+require "roby/app/test_impact"
 
 module Roby
     # Regular expression that matches backtrace paths that are within the
@@ -674,6 +675,70 @@ def log_setup(mod_path, level, file = nil)
 
         overridable_configuration "log", "filter_backtraces", predicate: true
 
+        ##
+        # :method: framework_backtrace_depth
+        #
+        # Maximum number of lines in the backtraces of errors generated by the
+        # framework itself. Nil (the default) for full backtraces
+        #
+        # See Roby.framework_backtrace_depth
+
+        ##
+        # :method: framework_backtrace_depth=
+        #
+        # Override the value stored in configuration files for
+        # framework_backtrace_depth
+
+        overridable_configuration "log", "framework_backtrace_depth"
+
+        ##
+        # :method: async_text_logs?
+        #
+        # True if the text loggers configured in log/levels should format and
+        # write their messages in a background thread (see {AsyncLogger})
+        #
+        # The messages are still built in the execution thread, and the
+        # loggers that are not listed in log/levels are not affected
+
+        ##
+        # :method: async_text_logs=
+        #
+        # Override the value stored in configuration files for
+        # async_text_logs?
+
+        overridable_configuration "log", "async", predicate: true,
+                                                  attr_name: "async_text_logs"
+
+        ##
+        # :method: async_text_logs_overflow
+        #
+        # What the async text loggers do when their queue is full, either
+        # 'drop' (the default) or 'block'. See {AsyncLogger#overflow}
+
+        ##
+        # :method: async_text_logs_overflow=
+        #
+        # Override the value stored in configuration files for
+        # async_text_logs_overflow
+
+        overridable_configuration "log", "async_overflow",
+                                  attr_name: "async_text_logs_overflow"
+
+        ##
+        # :method: async_text_logs_capacity
+        #
+        # How many messages the async text loggers can queue. See
+        # {AsyncLogger#capacity}
+
+        ##
+        # :method: async_text_logs_capacity=
+        #
+        # Override the value stored in configuration files for
+        # async_text_logs_capacity
+
+        overridable_configuration "log", "async_capacity",
+                                  attr_name: "async_text_logs_capacity"
+
         ##
         # :method: log_server?
         #
@@ -747,6 +812,8 @@ def initialize(plan: ExecutablePlan.new)
 
             @public_logs = false
             @log_create_current = true
+            @setup_state = nil
+            @reuse_reset_handler = nil
             @created_log_dirs = []
             @created_log_base_dirs = []
             @additional_model_files = []
@@ -854,6 +921,7 @@ def base_setup
                 find_and_create_log_dir
             end
             setup_loggers(redirections: true)
+            Roby.framework_backtrace_depth = framework_backtrace_depth
 
             # Set up the loaded plugins
             call_plugins(:base_setup, self)
@@ -878,6 +946,9 @@ def base_cleanup
                 @log_dir = nil
             end
 
+            # Write the messages queued by the async loggers before
+            # closing their files
+            AsyncLogger.stop_all
             log_files.each_value(&:close)
             log_files.clear
         end
@@ -978,30 +1049,46 @@ def prepare
                 setup_rest_interface
             end
 
-            if public_logs? && log_create_current?
-                FileUtils.rm_f File.join(log_base_dir, "current")
-                FileUtils.ln_s log_dir, File.join(log_base_dir, "current")
-            end
+            update_current_log_dir_link
+            prepare_event_log_and_server
+            @setup_state = capture_state(Roby::State)
+
+            call_plugins(:prepare, self)
+        end
 
-            if log["events"] && public_logs?
-                logfile_path = prepare_event_log
+        # @api private
+        #
+        # Update the log_base_dir/current symlink to point to {#log_dir}
+        def update_current_log_dir_link
+            return unless public_logs? && log_create_current?
 
-                # Start a log server if needed, and poll the log directory for new
-                # data sources
-                if log_server_options = (log.has_key?("server") ? log["server"] : {})
-                    unless log_server_options.kind_of?(Hash)
-                        log_server_options = {}
-                    end
-                    plan.event_logger.sync = true
-                    start_log_server(logfile_path, log_server_options)
-                    Roby.info "log server started"
-                else
-                    plan.event_logger.sync = false
-                    Roby.warn "log server disabled"
+            FileUtils.rm_f File.join(log_base_dir, "current")
+            FileUtils.ln_s log_dir, File.join(log_base_dir, "current")
+        end
+
+        # @api private
+        #
+        # Create the event log in {#log_dir} and start the log server on it,
+        # as configured by the log/events and log/server configuration
+        # entries
+        def prepare_event_log_and_server
+            return unless log["events"] && public_logs?
+
+            logfile_path = prepare_event_log
+
+            # Start a log server if needed, and poll the log directory for new
+            # data sources
+            if log_server_options = (log.has_key?("server") ? log["server"] : {})
+                unless log_server_options.kind_of?(Hash)
+                    log_server_options = {}
                 end
+                plan.event_logger.sync = true
+                start_log_server(logfile_path, log_server_options)
+                Roby.info "log server started"
+            else
+                plan.event_logger.sync = false
+                Roby.warn "log server disabled"
             end
-
-            call_plugins(:prepare, self)
         end
 
         # The inverse of #prepare. It gets called either at the end of #run or
@@ -1359,6 +1446,208 @@ def reset_plan(plan = ExecutablePlan.new)
             @plan = plan
         end
 
+        # Start logging in a new log directory
+        #
+        # The event log and the log server, if enabled, are switched to the
+        # new directory. Messages that have been logged for the current cycle
+        # are moved to the new event log, so this should be called while the
+        # plan is empty, before any plan object has been logged in the cycle.
+        #
+        # @param [String,nil] dir the new log directory. A new directory is
+        #   created under {#log_base_dir} if nil.
+        # @return [String] the new log directory
+        def rewind_log_dir(dir = nil)
+            old_logger = plan.event_logger
+            if dir
+                self.log_dir = dir
+                log_save_metadata
+            else
+                @time_tag = nil
+                find_and_create_log_dir
+            end
+            update_current_log_dir_link
+
+            stop_log_server
+            prepare_event_log_and_server
+            unless old_logger.equal?(plan.event_logger)
+                old_logger.close_into(plan.event_logger)
+            end
+            log_dir
+        end
+
+        # Whether a {#reset_for_reuse} is in progress
+        def resetting_for_reuse?
+            @reuse_reset_handler
+        end
+
+        # Bring a running app back to a clean plan so that it can be reused,
+        # e.g. by another test scenario, without having to restart it
+        #
+        # The plan is cleared the same way it is when the app quits, which
+        # requires a few cycles. Once it is empty, the state members that
+        # were created after {#setup} are removed, logging switches to a new
+        # log directory (see {#rewind_log_dir}) and the controller blocks are
+        # run again. Use {#resetting_for_reuse?} to know whether the reset
+        # is finished.
+        #
+        # It must be called from within the execution thread
+        #
+        # @param [String,nil] log_dir the log directory to switch to, see
+        #   {#rewind_log_dir}
+        # @param [Boolean] controller whether the controller blocks should be
+        #   run once the plan is clear
+        def reset_for_reuse(log_dir: nil, controller: true)
+            if resetting_for_reuse?
+                raise ArgumentError, "a reset is already in progress"
+            end
+
+            engine = execution_engine
+            @reuse_reset_handler = engine.at_cycle_end(
+                description: "Application#reset_for_reuse"
+            ) do
+                # ExecutionEngine#clear returns the tasks that are still
+                # being stopped
+                next if engine.clear
+
+                @reuse_reset_handler.dispose
+                # Wait for the next cycle so that the finalization messages
+                # from this one end up in the old log
+                engine.once(description: "Application#reset_for_reuse") do
+                    reset_state_for_reuse
+                    rewind_log_dir(log_dir)
+                    run_controller_blocks if controller
+                    @reuse_reset_handler = nil
+                end
+            end
+        end
+
+        # Path of the file used by {#save_plan_checkpoint} and
+        # {#restore_plan_checkpoint}
+        #
+        # It defaults to plan-checkpoint in {#log_base_dir}, so that it is
+        # shared by the successive runs of the app
+        #
+        # @return [String]
+        def plan_checkpoint_path
+            @plan_checkpoint_path || File.join(log_base_dir, "plan-checkpoint")
+        end
+
+        # Sets {#plan_checkpoint_path}
+        attr_writer :plan_checkpoint_path
+
+        # @!method restore_plan_checkpoint?
+        # @!method restore_plan_checkpoint=(flag)
+        #
+        # Whether 'roby run' should restore the plan checkpoint at startup
+        # instead of running the controllers and starting the actions given
+        # on the command line. It falls back to the latter if there is no
+        # checkpoint or if it cannot be restored
+        attr_predicate :restore_plan_checkpoint?, true
+
+        # Save a checkpoint of the jobs of {#plan}
+        #
+        # It must be called from within the execution thread. Checkpoints
+        # are saved periodically if the engine/plan_checkpoint_period
+        # configuration option is set.
+        #
+        # @return [PlanCheckpoint]
+        # @see PlanCheckpoint
+        def save_plan_checkpoint(path = plan_checkpoint_path)
+            checkpoint = PlanCheckpoint.capture(plan)
+            FileUtils.mkdir_p File.dirname(path)
+            checkpoint.save(path)
+            checkpoint
+        end
+
+        # Restore the checkpoint saved by {#save_plan_checkpoint} in {#plan}
+        #
+        # It must be called from within the execution thread
+        #
+        # @return [Array<Task>,nil] the restored tasks, or nil if there is no
+        #   checkpoint or if it could not be restored
+        def restore_plan_checkpoint(path = plan_checkpoint_path)
+            return unless File.file?(path)
+
+            tasks = PlanCheckpoint.load(path).restore(plan)
+            job_ids = tasks.map do |t|
+                t.job_id if t.fullfills?(Interface::Job)
+            end.compact
+            Interface::Job.reserve_job_id(job_ids.max) unless job_ids.empty?
+            Robot.info "restored #{tasks.size} tasks from the plan checkpoint #{path}"
+            tasks
+        rescue StandardError => e
+            Robot.warn "could not restore the plan checkpoint #{path}"
+            Roby.log_exception_with_backtrace(e, Robot, :warn)
+            nil
+        end
+
+        # @api private
+        #
+        # Restore the state as it was at the end of {#prepare}
+        #
+        # The members created since are removed, and the others get back the
+        # value they had
+        def reset_state_for_reuse
+            return unless (snapshot = @setup_state)
+
+            restore_state(Roby::State, snapshot)
+        end
+
+        # @api private
+        #
+        # Marker used by {#capture_state} for the values that cannot be
+        # marshalled. These values are left as-is by {#restore_state}
+        UNMARSHALLABLE_STATE_VALUE = Object.new.freeze
+
+        # @api private
+        #
+        # Captures the values of a state structure, to be restored later with
+        # {#restore_state}
+        #
+        # @param [OpenStruct] struct
+        # @return [Hash<String,Object>] a mapping from the member names to
+        #   either the snapshot of a sub-structure (as a Hash), the marshalled
+        #   value (as a String) or {UNMARSHALLABLE_STATE_VALUE}
+        def capture_state(struct)
+            struct.each_member.each_with_object({}) do |(name, value), snapshot|
+                snapshot[name] =
+                    if value.kind_of?(OpenStruct)
+                        capture_state(value)
+                    else
+                        begin
+                            Marshal.dump(value)
+                        rescue TypeError
+                            UNMARSHALLABLE_STATE_VALUE
+                        end
+                    end
+            end
+        end
+
+        # @api private
+        #
+        # Restores a state structure captured by {#capture_state}
+        #
+        # @param [OpenStruct] struct
+        # @param [Hash<String,Object>] snapshot
+        def restore_state(struct, snapshot)
+            struct.each_member.map(&:first).each do |name|
+                struct.delete(name) unless snapshot.key?(name)
+            end
+
+            snapshot.each do |name, value|
+                if value.kind_of?(Hash)
+                    current = struct.get(name)
+                    unless current.kind_of?(OpenStruct)
+                        struct.delete(name) unless current.nil?
+                        current = struct.__get(name)
+                    end
+                    restore_state(current, value) if current
+                elsif !value.equal?(UNMARSHALLABLE_STATE_VALUE)
+                    struct.set(name, Marshal.load(value))
+                end
+            end
+        end
+
         # Explicitely set the log directory
         #
         # It is usually automatically created under {#log_base_dir} during
@@ -1586,7 +1875,7 @@ def setup_loggers(ignore_missing: false, redirections: true)
                      else
                          STDOUT
                      end
-                new_logger = Logger.new(io)
+                new_logger = create_text_logger(io)
                 new_logger.level     = level
                 new_logger.formatter = mod.logger.formatter
                 new_logger.progname = [name, robot_name].compact.join(" ")
@@ -1594,6 +1883,25 @@ def setup_loggers(ignore_missing: false, redirections: true)
             end
         end
 
+        # @api private
+        #
+        # Creates a logger for {#setup_loggers}
+        #
+        # @return [Logger,AsyncLogger] an {AsyncLogger} if
+        #   {#async_text_logs?} is set, and a plain logger otherwise
+        def create_text_logger(io)
+            return Logger.new(io) unless async_text_logs?
+
+            options = {}
+            if (overflow = async_text_logs_overflow)
+                options[:overflow] = overflow.to_sym
+            end
+            if (capacity = async_text_logs_capacity)
+                options[:capacity] = Integer(capacity)
+            end
+            AsyncLogger.new(io, **options)
+        end
+
         # Register a server port that can be discovered later
         def register_server(name, port); end
 
@@ -1752,9 +2060,17 @@ def load_default_models
         # Returns the downmost app file that was involved in the given model's
         # definition
         def definition_file_for(model)
-            return if !model.respond_to?(:definition_location) || !model.definition_location
+            definition_files_for(model).first
+        end
 
-            model.definition_location.each do |location|
+        # Returns the app files under models/ that were involved in the given
+        # model's definition, downmost first
+        #
+        # @return [Array<String>]
+        def definition_files_for(model)
+            return [] if !model.respond_to?(:definition_location) || !model.definition_location
+
+            model.definition_location.each_with_object([]) do |location, files|
                 file = location.absolute_path
                 next unless (base_path = find_base_path_for(file))
 
@@ -1762,9 +2078,8 @@ def definition_file_for(model)
                 split = relative.each_filename.to_a
                 next if split[0] != "models"
 
-                return file
+                files << file unless files.include?(file)
             end
-            nil
         end
 
         # Given a model class, returns the full path of an existing test file
@@ -2035,6 +2350,19 @@ def run(report_on_exception: true, thread_priority: 0, &block)
             engine_config = self.engine
             engine = self.plan.execution_engine
             plugins = self.plugins.map { |_, mod| mod if mod.respond_to?(:start) || mod.respond_to?(:run) }.compact
+            if engine_config.key?("provenance_retention")
+                engine.provenance_retention = engine_config["provenance_retention"]
+            end
+            if engine_config["deferred_exception_display"]
+                engine.exception_display_executor =
+                    Concurrent::SingleThreadExecutor.new
+            end
+            if (period = engine_config["plan_checkpoint_period"])
+                engine.every(period, description: "plan checkpoint",
+                                     on_error: :ignore) do
+                    save_plan_checkpoint
+                end
+            end
             engine.once do
                 run_plugins(plugins, &block)
             end
@@ -2159,6 +2487,9 @@ def start_log_server(logfile, options = {})
             tcp_server = TCPServer.new(Integer(options["port"] || 0))
             server_flags = ["--fd=#{tcp_server.fileno}", "--sampling=#{sampling_period}", logfile]
             redirect_flags = Hash[tcp_server => tcp_server]
+            if (max_client_backlog = options["max_client_backlog"])
+                server_flags << "--max-client-backlog=#{max_client_backlog}"
+            end
             if options["debug"]
                 server_flags << "--debug"
             elsif options["silent"]
@@ -2989,6 +3320,36 @@ def discover_test_files(all: true, only_self: false)
             test_files
         end
 
+        # Path of the file in which {#select_impacted_test_files} saves the
+        # test dependencies between runs
+        #
+        # It is specific to the robot name, as the loaded models and hence the
+        # test dependencies depend on it
+        def test_impact_cache_path
+            File.join(log_base_dir, "test-impact-#{robot_name || 'default'}.yml")
+        end
+
+        # Selects the test files that are affected by the changes since the
+        # last successful run
+        #
+        # The returned {App::TestImpact} object must be saved with
+        # {App::TestImpact#save} once the tests pass, so that the next
+        # selection is done relative to this run.
+        #
+        # @param [Hash<String,Set>] test_files the test files and the models
+        #   they test, as returned by {#discover_test_files}
+        # @param [String] cache_path the path where the dependencies from the
+        #   previous run have been saved
+        # @return [(Hash<String,Array<String>>,App::TestImpact)] the selected
+        #   test files and the reasons for which they have been selected, and
+        #   the information for the current run
+        def select_impacted_test_files(test_files, cache_path: test_impact_cache_path)
+            impact = App::TestImpact.from_app(self, test_files)
+            impact.update_digests
+            selection = impact.select(App::TestImpact.load(cache_path))
+            [selection, impact]
+        end
+
         # Hook for the plugins to filter out some paths that should not be
         # auto-loaded by {#each_test_file_in_app}. It does not affect
         # {#each_test_file_for_loaded_models}.
@@ -1,6 +1,7 @@
 # frozen_string_literal: true
 
 require "roby/interface/async"
+require "roby/app/cucumber/controller_pool"
 
 module Roby
     module App
@@ -48,6 +49,16 @@ class InvalidState < RuntimeError; end
                 # ROBY_VALIDATE_STEPS to '1'
                 attr_predicate :validation_mode?, true
 
+                # The pool from which controllers are taken, if there is one
+                #
+                # @return [ControllerPool,nil]
+                attr_reader :pool
+
+                # The process taken from {#pool} by {#roby_start}
+                #
+                # @return [ControllerPool::PooledProcess,nil]
+                attr_reader :pooled_process
+
                 # Whether this started a Roby controller
                 def roby_running?
                     @roby_pid
@@ -61,9 +72,13 @@ def roby_connected?
                 def initialize(
                     port: Roby::Interface::DEFAULT_PORT,
                     keep_running: (ENV["CUCUMBER_KEEP_RUNNING"] == "1"),
-                    validation_mode: (ENV["ROBY_VALIDATE_STEPS"] == "1")
+                    validation_mode: (ENV["ROBY_VALIDATE_STEPS"] == "1"),
+                    pool: nil
                 )
                     @roby_pid = nil
+                    @pool = pool
+                    @pooled_process = nil
+                    @pending_reset = nil
                     @roby_interface = Roby::Interface::Async::Interface
                                       .new("localhost", port: port)
                     @background_jobs = []
@@ -82,6 +97,10 @@ def initialize(
                 #   blocks should be executed
                 # @param [Hash] state initial values for the state
                 #
+                # If {#pool} is set, the controller is taken from it instead of
+                # being started, and reset on connection. spawn_options are
+                # then ignored, and are instead controlled by the pool.
+                #
                 # @raise InvalidState if a controller is already running
                 def roby_start(
                     robot_name, robot_type,
@@ -94,9 +113,36 @@ def roby_start(
                               "call #roby_stop and #roby_join first"
                     end
 
+                    if pool
+                        roby_start_from_pool(
+                            robot_name, robot_type,
+                            app_dir: app_dir, log_dir: log_dir, state: state
+                        )
+                    else
+                        @roby_pid = self.class.spawn_roby(
+                            robot_name, robot_type,
+                            app_dir: app_dir, log_dir: log_dir, state: state,
+                            **spawn_options
+                        )
+                    end
+                    roby_connect if connect
+                    roby_pid
+                end
+
+                # @api private
+                #
+                # Spawn a Roby controller process
+                #
+                # @return [Integer] the process PID
+                def self.spawn_roby(
+                    robot_name, robot_type,
+                    app_dir: Dir.pwd, log_dir: nil, port: nil, state: {},
+                    **spawn_options
+                )
                     options = []
                     options << "--log-dir=#{log_dir}" if log_dir
-                    @roby_pid = spawn(
+                    options << "--port=#{port}" if port
+                    spawn(
                         Gem.ruby, File.join(Roby::BIN_DIR, "roby"), "run",
                         "--robot=#{robot_name},#{robot_type}",
                         "--controller",
@@ -107,8 +153,58 @@ def roby_start(
                         pgroup: 0,
                         **spawn_options
                     )
-                    roby_connect if connect
-                    roby_pid
+                end
+
+                # @api private
+                #
+                # Take a controller from {#pool} and set up the interface to
+                # communicate with it
+                def roby_start_from_pool(
+                    robot_name, robot_type, app_dir:, log_dir:, state:
+                )
+                    key = ControllerPool.key(
+                        robot_name, robot_type, app_dir: app_dir, state: state
+                    )
+                    @pooled_process = pool.acquire(key)
+                    @roby_pid = pooled_process.pid
+                    @roby_interface = Roby::Interface::Async::Interface
+                                      .new("localhost", port: pooled_process.port)
+                    @pending_reset = { log_dir: log_dir }
+                end
+
+                class ResetTimeout < RuntimeError
+                end
+
+                # Reset the plan and state of the connected Roby controller
+                #
+                # The controller switches to a new log directory as well.
+                #
+                # @param [String,nil] log_dir the log directory to switch to.
+                #   A new one is created if nil.
+                # @raise ResetTimeout if the reset did not finish within
+                #   timeout seconds
+                def roby_reset(log_dir: nil, timeout: 20)
+                    unless roby_connected?
+                        raise InvalidState,
+                              "you need to successfully connect to the Roby "\
+                              "controller with #roby_connect before you can call "\
+                              "#roby_reset"
+                    end
+
+                    client = roby_interface.client
+                    client.reset(log_dir: log_dir)
+                    deadline = Time.now + timeout
+                    until client.reset_finished?
+                        if Time.now > deadline
+                            raise ResetTimeout,
+                                  "failed to reset the Roby controller in less "\
+                                  "than #{timeout}s"
+                        end
+                        sleep 0.05
+                    end
+                    @background_jobs.clear
+                    @pending_actions.clear
+                    @current_batch = roby_interface.create_batch
                 end
 
                 # Try connecting to the Roby controller
@@ -152,6 +248,10 @@ def roby_connect(timeout: 20)
                         end
                     end
                     @current_batch = @roby_interface.create_batch
+                    return unless (reset = @pending_reset)
+
+                    @pending_reset = nil
+                    roby_reset(**reset)
                 end
 
                 # Disconnect the interface to the controller, but does not stop
@@ -179,6 +279,8 @@ def roby_stop(join: true, join_timeout: 5)
                               "#roby_stop"
                     end
 
+                    return roby_release_to_pool if pooled_process
+
                     begin
                         roby_interface.quit
                     rescue Interface::ComError
@@ -192,6 +294,16 @@ def roby_stop(join: true, join_timeout: 5)
                                       signal: "INT", next_signal: "KILL")
                 end
 
+                # @api private
+                #
+                # Give the controller back to {#pool} instead of stopping it
+                def roby_release_to_pool
+                    roby_interface.close
+                    pool.release(pooled_process)
+                    @pooled_process = nil
+                    @roby_pid = nil
+                end
+
                 # Kill the Roby controller process
                 def roby_kill(join: true, join_timeout: 5, signal: "INT")
                     unless roby_running?
@@ -240,9 +352,11 @@ def roby_join(timeout: nil)
                         _, status = Process.waitpid2(roby_pid)
                     end
                     @roby_pid = nil
+                    @pooled_process = nil
                     status
                 rescue Errno::ECHILD
                     @roby_pid = nil
+                    @pooled_process = nil
                 end
 
                 # Wait for the remote process to quit
@@ -0,0 +1,166 @@
+# frozen_string_literal: true
+
+require "socket"
+
+module Roby
+    module App
+        module Cucumber
+            # A set of Roby controllers started ahead of time
+            #
+            # Starting a Roby app can take a long time. A pool lets a
+            # {Controller} take an already-running process in
+            # {Controller#roby_start}, reset it (see
+            # {Interface::Interface#reset}) and give it back in
+            # {Controller#roby_stop}. Each time a process is taken, a new one
+            # is spawned so that {#size} processes are booting or idle in the
+            # background.
+            #
+            # Processes are only shared between {Controller#roby_start} calls
+            # that would have started the same command line, i.e. that have
+            # the same robot name and type, app dir and state.
+            class ControllerPool
+                # A process managed by the pool
+                #
+                # @!method key
+                #   the parameters that were used to spawn the process
+                # @!method pid
+                #   the process PID
+                # @!method port
+                #   the port of the process' shell interface
+                PooledProcess = Struct.new :key, :pid, :port
+
+                # The number of processes that should be kept ready for each
+                # key
+                #
+                # @return [Integer]
+                attr_reader :size
+
+                # Options passed to Kernel#spawn when starting new processes
+                #
+                # @return [Hash]
+                attr_reader :spawn_options
+
+                def initialize(size: 1, **spawn_options)
+                    @size = size
+                    @spawn_options = spawn_options
+                    @idle = Hash.new { |h, k| h[k] = [] }
+                end
+
+                # The processes that are not used by any controller
+                #
+                # @return [Array<PooledProcess>]
+                def idle_processes
+                    @idle.values.flatten
+                end
+
+                # Take a process matching the given key
+                #
+                # The idle process that was started first is returned. A new
+                # process is started if there are none. The pool is then
+                # replenished.
+                #
+                # @param key the command line parameters, as returned by
+                #   {.key}
+                # @return [PooledProcess]
+                def acquire(key)
+                    reap
+                    process = @idle[key].shift || spawn_process(key)
+                    replenish(key)
+                    process
+                end
+
+                # Give back a process acquired with {#acquire}
+                #
+                # Processes in excess of {#size} are stopped
+                #
+                # @param [PooledProcess] process
+                def release(process)
+                    idle = @idle[process.key]
+                    idle << process
+                    stop_process(idle.shift) while idle.size > size
+                end
+
+                # Start new processes until there are {#size} idle processes
+                # for the given key
+                def replenish(key)
+                    idle = @idle[key]
+                    idle << spawn_process(key) while idle.size < size
+                end
+
+                # Remove the idle processes that terminated
+                def reap
+                    @idle.each_value do |processes|
+                        processes.delete_if { |p| terminated?(p) }
+                    end
+                end
+
+                # @api private
+                #
+                # Whether the given process is finished
+                def terminated?(process)
+                    ::Process.waitpid2(process.pid, ::Process::WNOHANG)
+                rescue Errno::ECHILD
+                    true
+                end
+
+                # Stop all idle processes
+                def shutdown
+                    @idle.each_value do |processes|
+                        processes.each { |p| stop_process(p) }
+                    end
+                    @idle.clear
+                end
+
+                # The pool key for the given command line parameters
+                def self.key(robot_name, robot_type, app_dir:, state: {})
+                    [robot_name, robot_type, File.expand_path(app_dir),
+                     state.to_a.sort_by(&:first)]
+                end
+
+                # @api private
+                #
+                # Start a new Roby process
+                #
+                # @return [PooledProcess]
+                def spawn_process(key)
+                    robot_name, robot_type, app_dir, state = *key
+                    port = allocate_port
+                    pid = Controller.spawn_roby(
+                        robot_name, robot_type,
+                        app_dir: app_dir, port: port, state: state.to_h,
+                        **spawn_options
+                    )
+                    PooledProcess.new(key, pid, port)
+                end
+
+                # @api private
+                #
+                # Find a free port for a new process' shell interface
+                def allocate_port
+                    server = TCPServer.new("localhost", 0)
+                    server.local_address.ip_port
+                ensure
+                    server&.close
+                end
+
+                # @api private
+                #
+                # Stop a process, killing it if it does not quit within
+                # join_timeout seconds
+                def stop_process(process, join_timeout: 5)
+                    ::Process.kill("INT", process.pid)
+                    deadline = Time.now + join_timeout
+                    until ::Process.waitpid2(process.pid, ::Process::WNOHANG)
+                        if Time.now > deadline
+                            ::Process.kill("KILL", process.pid)
+                            ::Process.waitpid2(process.pid)
+                            break
+                        end
+                        sleep 0.1
+                    end
+                rescue Errno::ECHILD, Errno::ESRCH # rubocop:disable Lint/SuppressedException
+                end
+            end
+        end
+    end
+end
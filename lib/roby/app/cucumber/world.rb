@@ -5,11 +5,28 @@
 module Roby
     module App
         module Cucumber
+            # The controller pool shared by all scenarios
+            #
+            # It is enabled by setting ROBY_CONTROLLER_POOL_SIZE to the number
+            # of controllers that should be kept ready
+            #
+            # @return [ControllerPool,nil]
+            def self.controller_pool
+                return @controller_pool if @controller_pool
+
+                size = Integer(ENV["ROBY_CONTROLLER_POOL_SIZE"] || 0)
+                return if size == 0
+
+                @controller_pool = ControllerPool.new(size: size)
+                at_exit { @controller_pool.shutdown }
+                @controller_pool
+            end
+
             module World
                 attr_reader :roby_controller
 
                 def roby_world_initialize
-                    @roby_controller = Controller.new
+                    @roby_controller = Controller.new(pool: Cucumber.controller_pool)
                 end
 
                 def self.extend_object(world)
@@ -56,6 +56,10 @@
 end
 
 test_files = parser.parse(ARGV)
+if test_files.empty?
+    # Needed to map the models to their test files
+    MetaRuby.keep_definition_location = true
+end
 
 if !server_pid
     require "roby/app/test_server"
@@ -124,9 +128,9 @@
         begin
             reporter.discovery_start
             if test_files.empty?
-                test_files = Roby.app.each_model.map do |m|
-                    [m, Roby.app.test_file_for(m)]
-                end.compact
+                test_files = Roby.app.each_test_file_for_loaded_models.map do |path, models|
+                    [models.first, path]
+                end
             else
                 test_files = test_files.map { |path| [nil, path] }
             end
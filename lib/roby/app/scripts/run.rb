@@ -69,6 +69,10 @@
     opt.on "-c", "--controller", "run the controller files and blocks" do
         run_controller = true
     end
+    opt.on "--restore-plan", "restore the jobs from the last plan checkpoint "\
+                             "instead of starting the actions and controllers" do
+        app.restore_plan_checkpoint = true
+    end
     opt.on "-p", "--plugin=PLUGIN", String, "load this plugin" do |plugin|
         Roby.app.using plugin
     end
@@ -136,12 +140,19 @@
                 next if Roby.app.shell_interface.client_count(handshake: true) == 0
             end
 
-            # Start the requested actions
-            actions.each do |act|
-                Roby.plan.add_mission_task(act.plan_pattern)
+            restored = (Roby.app.restore_plan_checkpoint if Roby.app.restore_plan_checkpoint?)
+
+            if restored
+                Robot.info "jobs restored from the plan checkpoint, not starting "\
+                           "the actions and controllers"
+            else
+                # Start the requested actions
+                actions.each do |act|
+                    Roby.plan.add_mission_task(act.plan_pattern)
+                end
             end
 
-            if run_controller
+            if run_controller && !restored
                 # Load the controller
                 controller_file =
                     Roby.app.find_file("scripts", "controllers", "ROBOT.rb",
@@ -17,6 +17,7 @@
 MetaRuby.keep_definition_location = false
 
 list_tests = false
+impacted = false
 coverage_mode = false
 only_self = false
 all = true
@@ -50,6 +51,14 @@
                      "but does not execute them") do
         list_tests = true
     end
+    opt.on("--impacted", "only run the tests affected by the changes since "\
+                         "the last successful --impacted run. Only the models "\
+                         "are tracked: a change in any other Ruby file of the "\
+                         "app (lib/, config/, test helpers) selects all tests, "\
+                         "and changes outside the app are only detected in "\
+                         "files that define a tested model") do
+        impacted = true
+    end
     opt.on("-l", "--live", "run tests in live mode") do |val|
         Roby.app.simulation = !val
     end
@@ -87,6 +96,7 @@
 if test_files.empty?
     MetaRuby.keep_definition_location = true
 end
+test_impact = nil
 
 if coverage_mode
     require "simplecov"
@@ -104,7 +114,18 @@
         if test_files.empty?
             test_files = app.discover_test_files(
                 all: all, only_self: only_self
-            ).map(&:first)
+            )
+            if impacted
+                selection, test_impact = app.select_impacted_test_files(test_files)
+                puts "Selected #{selection.size} of #{test_files.size} test files "\
+                     "affected by changes since the last run"
+                selection.keys.sort.each do |path|
+                    puts "  #{path}"
+                    selection[path].each { |reason| puts "    #{reason}" }
+                end
+                test_files = selection
+            end
+            test_files = test_files.map(&:first)
             self_files, dependent_files =
                 test_files.partition { |f| app.self_file?(f) }
             test_files = self_files.sort + dependent_files.sort
@@ -135,6 +156,8 @@
         end
         passed = Minitest.run(testrb_args)
         exit(1) unless passed
+
+        test_impact&.save(app.test_impact_cache_path)
     ensure
         Roby.app.shutdown
         Roby.app.cleanup
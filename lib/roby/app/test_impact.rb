@@ -0,0 +1,276 @@
+# frozen_string_literal: true
+
+require "digest/sha1"
+require "fileutils"
+require "set"
+require "yaml"
+
+module Roby
+    module App
+        # Selection of the test files that are affected by changes in the app
+        #
+        # The object maps each test file to the app files the models it tests
+        # depend on: the files that define the models themselves, their
+        # parent models and the services they provide and, for action
+        # interfaces, the models returned by their actions. Each dependency is
+        # recorded along with the reason it exists, so that a selection can
+        # be explained.
+        #
+        # Only the models are tracked. The other Ruby files of the app (e.g.
+        # lib/, config/ or the test helpers) are therefore global
+        # dependencies: a change in any of them selects all the test files.
+        # Changes in files outside the app that do not define a tested model
+        # are not detected.
+        #
+        # The map is saved, along with a digest of all the files it involves,
+        # after a successful test run (see {#save}). At the next run, the test
+        # files whose dependencies changed since are selected with {#select}.
+        class TestImpact
+            # A dependency of a test file
+            #
+            # @!attribute path
+            #   @return [String] the path of the file the test depends on
+            # @!attribute reason
+            #   @return [String] why the test depends on this file
+            Dependency = Struct.new :path, :reason
+
+            # The test files and their dependencies
+            #
+            # @return [Hash<String,Set<Dependency>>]
+            attr_reader :dependencies
+
+            # The dependencies shared by all test files
+            #
+            # @return [Set<Dependency>]
+            attr_reader :global_dependencies
+
+            # The digest of the files involved in {#dependencies}
+            #
+            # It is empty until {#update_digests} is called
+            #
+            # @return [Hash<String,String>]
+            attr_reader :digests
+
+            def initialize(dependencies = {}, digests = {},
+                           global_dependencies: Set.new)
+                @dependencies = dependencies
+                @global_dependencies = global_dependencies
+                @digests = digests
+            end
+
+            # Computes the dependencies of the test files of an app
+            #
+            # @param [Application] app
+            # @param [Hash<String,Set>] test_files the test files and the
+            #   models they test, as returned by
+            #   {Application#discover_test_files}
+            # @return [TestImpact]
+            def self.from_app(app, test_files = app.discover_test_files(all: true))
+                impact = new
+                test_files.each do |test_path, models|
+                    impact.add_test_file(test_path)
+                    models.each do |m|
+                        impact.add_model_dependencies(app, test_path, m)
+                    end
+                end
+                impact.add_app_global_dependencies(app)
+                impact
+            end
+
+            # Loads the information saved by {#save}
+            #
+            # @return [TestImpact,nil] the saved information, or nil if the file
+            #   does not exist or cannot be read
+            def self.load(path)
+                return unless File.file?(path)
+
+                data = YAML.safe_load(File.read(path))
+                return unless data.kind_of?(Hash)
+
+                dependencies = (data["dependencies"] || {})
+                    .each_with_object({}) do |(test_path, deps), h|
+                        h[test_path] = deps.map { |p, r| Dependency.new(p, r) }.to_set
+                    end
+                global_dependencies = (data["global_dependencies"] || [])
+                    .map { |p, r| Dependency.new(p, r) }.to_set
+                new(dependencies, data["digests"] || {},
+                    global_dependencies: global_dependencies)
+            rescue Psych::SyntaxError => e
+                Roby.warn "ignoring invalid test impact information in #{path}: "\
+                          "#{e.message}"
+                nil
+            end
+
+            # Saves the dependencies and the file digests
+            #
+            # @param [String] path
+            def save(path)
+                dependencies = self.dependencies.each_with_object({}) do |(test_path, deps), h|
+                    h[test_path] = deps.map { |d| [d.path, d.reason] }
+                end
+                FileUtils.mkdir_p File.dirname(path)
+                global_dependencies = self.global_dependencies.map { |d| [d.path, d.reason] }
+                File.write(path, YAML.dump("dependencies" => dependencies,
+                                           "global_dependencies" => global_dependencies,
+                                           "digests" => digests))
+            end
+
+            # Registers a test file without dependencies
+            def add_test_file(test_path)
+                dependencies[test_path] ||= Set.new
+            end
+
+            # Registers a dependency of a test file
+            #
+            # @param [String] test_path
+            # @param [String] path the path of the file the test depends on
+            # @param [String] reason why the test depends on the file
+            def add(test_path, path, reason)
+                add_test_file(test_path) << Dependency.new(path, reason)
+            end
+
+            # Registers a dependency of all test files
+            #
+            # @param [String] path the path of the file the tests depend on
+            # @param [String] reason why the tests depend on the file
+            def add_global(path, reason)
+                global_dependencies << Dependency.new(path, reason)
+            end
+
+            # Registers the Ruby files of the app that are neither models nor
+            # test files as dependencies of all test files
+            #
+            # @param [Application] app
+            def add_app_global_dependencies(app)
+                return unless (app_dir = app.app_dir)
+
+                models_dir = File.join(app_dir, "models", "")
+                test_dir = File.join(app_dir, "test", "")
+                Dir.glob(File.join(app_dir, "**", "*.rb")).each do |path|
+                    next if path.start_with?(models_dir)
+                    next if path.start_with?(test_dir) &&
+                            File.basename(path).start_with?("test_")
+
+                    add_global(path, "it is not a model file, so any test may use it")
+                end
+            end
+
+            # Registers the dependencies that a test file inherits from a model
+            #
+            # @param [Application] app
+            # @param [String] test_path
+            # @param [Module] model
+            def add_model_dependencies(app, test_path, model)
+                app.definition_files_for(model).each do |path|
+                    add(test_path, path, "#{model.name} is defined there")
+                end
+
+                if model.respond_to?(:ancestors)
+                    model.ancestors.each do |parent_m|
+                        next if parent_m == model
+
+                        relation = parent_m.kind_of?(Class) ? "is a submodel of" : "provides"
+                        app.definition_files_for(parent_m).each do |path|
+                            add(test_path, path,
+                                "#{model.name} #{relation} #{parent_m.name}, defined there")
+                        end
+                    end
+                end
+
+                if model.respond_to?(:each_action)
+                    model.each_action do |action|
+                        returned_m = action.returned_type
+                        [returned_m, *returned_m.ancestors].uniq.each do |m|
+                            app.definition_files_for(m).each do |path|
+                                add(test_path, path,
+                                    "action #{action.name} of #{model.name} returns "\
+                                    "#{returned_m.name}, which depends on #{m.name} "\
+                                    "defined there")
+                            end
+                        end
+                    end
+                end
+            end
+
+            # Enumerates the files involved in the dependencies, test files
+            # included
+            #
+            # @yieldparam [String] path
+            def each_file
+                return enum_for(__method__) unless block_given?
+
+                global_dependencies.each { |d| yield(d.path) }
+                dependencies.each do |test_path, deps|
+                    yield(test_path)
+                    deps.each { |d| yield(d.path) }
+                end
+            end
+
+            # Computes the digest of all the files in {#each_file}
+            def update_digests
+                @digests = each_file.to_set.each_with_object({}) do |path, h|
+                    if (digest = self.class.digest(path))
+                        h[path] = digest
+                    end
+                end
+            end
+
+            # Computes the digest of a file
+            #
+            # @return [String,nil] the digest, or nil if the file does not exist
+            def self.digest(path)
+                Digest::SHA1.file(path).hexdigest if File.file?(path)
+            end
+
+            # Selects the test files affected by the changes since a previous
+            # run
+            #
+            # The dependencies of both this object and the previous run are
+            # considered, so that a test file gets selected if a file it does
+            # not depend on anymore changed. All test files are selected if
+            # one of the {#global_dependencies} changed.
+            #
+            # @param [TestImpact,nil] previous the information saved at the
+            #   previous run. If nil, all test files are selected.
+            # @return [Hash<String,Array<String>>] the selected test files and
+            #   the reasons for which they were selected
+            def select(previous)
+                update_digests if digests.empty?
+
+                if previous
+                    global_reasons =
+                        (global_dependencies | previous.global_dependencies)
+                        .find_all { |d| changed?(d.path, previous) }
+                        .map { |d| "#{d.path} changed: #{d.reason}" }
+                end
+
+                selection = {}
+                dependencies.each do |test_path, deps|
+                    unless previous
+                        selection[test_path] = ["no test impact information from a previous run"]
+                        next
+                    end
+
+                    reasons = global_reasons.dup
+                    if changed?(test_path, previous)
+                        reasons << "the test file changed"
+                    end
+
+                    previous_deps = previous.dependencies[test_path] || Set.new
+                    (deps | previous_deps).each do |d|
+                        if changed?(d.path, previous)
+                            reasons << "#{d.path} changed: #{d.reason}"
+                        end
+                    end
+                    selection[test_path] = reasons unless reasons.empty?
+                end
+                selection
+            end
+
+            # Whether a file changed since a previous run
+            def changed?(path, previous)
+                digests.fetch(path) { self.class.digest(path) } != previous.digests[path]
+            end
+        end
+    end
+end
@@ -0,0 +1,217 @@
+# frozen_string_literal: true
+
+require "logger"
+require "set"
+
+module Roby
+    # A text logger that does its I/O in a background thread
+    #
+    # The logging thread checks the log level and builds the message as
+    # usual: a message block (e.g. Roby.debug { ... }) is evaluated right
+    # away, in the logging thread. The severity, the time, the progname and
+    # the message are then queued in a bounded queue. The writer thread
+    # calls the formatter and writes the result.
+    #
+    # The message object itself is converted into a string by the
+    # formatter, i.e. later and in the writer thread. Pass strings, or
+    # objects that the logging thread does not modify afterwards.
+    #
+    # When the queue is full, the message is either discarded (overflow:
+    # :drop, the default) or the logging thread waits for the writer
+    # (overflow: :block). Discarded messages are counted in
+    # {#dropped_count}, and reported in the log itself.
+    #
+    # The queue is written by {#flush}, {#stop} and {#close}. All running
+    # async loggers are stopped at exit.
+    class AsyncLogger < ::Logger
+        # The valid values for the overflow parameter of {#initialize}
+        OVERFLOW_POLICIES = %i[drop block].freeze
+
+        # How many messages can be queued
+        #
+        # @return [Integer]
+        attr_reader :capacity
+
+        # What happens when a message is logged while the queue is full
+        #
+        # @return [Symbol] one of {OVERFLOW_POLICIES}
+        attr_reader :overflow
+
+        # The number of messages discarded because the queue was full
+        #
+        # @return [Integer]
+        attr_reader :dropped_count
+
+        # @param io the log device, as accepted by Logger
+        # @param [Integer] capacity the queue size
+        # @param [Symbol] overflow one of {OVERFLOW_POLICIES}
+        def initialize(io, capacity: 10_000, overflow: :drop)
+            unless OVERFLOW_POLICIES.include?(overflow)
+                raise ArgumentError,
+                      "invalid overflow policy #{overflow.inspect}, expected "\
+                      "one of #{OVERFLOW_POLICIES.map(&:inspect).join(', ')}"
+            end
+
+            super(io)
+            @capacity = capacity
+            @overflow = overflow
+            @dropped_count = 0
+            @reported_dropped_count = 0
+            @dropped_count_lock = Mutex.new
+            @queue = SizedQueue.new(capacity)
+            @writer = Thread.new { write_loop }
+            @writer.name = "Roby::AsyncLogger"
+            AsyncLogger.register(self)
+        end
+
+        # Whether the writer thread is still processing messages
+        def open?
+            @writer
+        end
+
+        # Queues a message
+        #
+        # It has the same semantic than Logger#add. The message block, if
+        # given, is evaluated in the calling thread. The formatting and the
+        # I/O are done in the writer thread
+        def add(severity, message = nil, progname = nil)
+            severity ||= UNKNOWN
+            return true if severity < level
+            return super unless open?
+
+            progname ||= self.progname
+            if message.nil?
+                if block_given?
+                    message = yield
+                else
+                    message = progname
+                    progname = self.progname
+                end
+            end
+            push([severity, Time.now, progname, message])
+            true
+        end
+        alias log add
+
+        # Waits for all the messages queued so far, and the report of the
+        # messages dropped so far, to be written
+        def flush
+            return unless open?
+
+            done = Queue.new
+            @queue.push(done)
+            done.pop
+            dev = @logdev&.dev
+            dev.flush if dev.respond_to?(:flush)
+            nil
+        end
+
+        # Writes the pending messages and stops the writer thread
+        #
+        # Messages logged afterwards are written synchronously. Unlike
+        # {#close}, the log device is left open
+        def stop
+            return unless (writer = @writer)
+
+            @queue.push(nil)
+            writer.join
+            @writer = nil
+            AsyncLogger.deregister(self)
+            nil
+        end
+
+        # Stops the writer thread and closes the log device
+        def close
+            stop
+            super
+        end
+
+        # @api private
+        #
+        # Queues a message entry, applying the overflow policy
+        def push(entry)
+            if overflow == :block
+                @queue.push(entry)
+            else
+                begin
+                    @queue.push(entry, true)
+                rescue ThreadError
+                    @dropped_count_lock.synchronize { @dropped_count += 1 }
+                end
+            end
+        end
+
+        # @api private
+        #
+        # Main loop of the writer thread
+        def write_loop
+            while (entry = @queue.pop)
+                if entry.kind_of?(Queue)
+                    report_dropped_messages
+                    entry.push(true)
+                else
+                    write_entry(*entry)
+                end
+                report_dropped_messages if @queue.empty?
+            end
+            report_dropped_messages
+        end
+
+        # @api private
+        #
+        # Formats and writes a single message
+        def write_entry(severity, time, progname, message)
+            @logdev&.write(
+                format_message(format_severity(severity), time, progname, message)
+            )
+        rescue Exception => e # rubocop:disable Lint/RescueException
+            ::Kernel.warn "Roby::AsyncLogger: failed to write message: #{e.message}"
+        end
+
+        # @api private
+        #
+        # Writes a message about the messages that have been dropped since
+        # the last report
+        def report_dropped_messages
+            count = @dropped_count
+            dropped = count - @reported_dropped_count
+            return if dropped == 0
+
+            @reported_dropped_count = count
+            write_entry(
+                WARN, Time.now, progname,
+                "#{dropped} log messages dropped because the queue was full"
+            )
+        end
+
+        @open_loggers = Set.new
+        @open_loggers_lock = Mutex.new
+
+        class << self
+            # @api private
+            #
+            # Registers a logger so that it is stopped at exit
+            def register(logger)
+                @open_loggers_lock.synchronize do
+                    unless @at_exit_registered
+                        at_exit { stop_all }
+                        @at_exit_registered = true
+                    end
+                    @open_loggers << logger
+                end
+            end
+
+            # @api private
+            def deregister(logger)
+                @open_loggers_lock.synchronize { @open_loggers.delete(logger) }
+            end
+
+            # Stops all the running async loggers, writing their pending
+            # messages
+            def stop_all
+                loggers = @open_loggers_lock.synchronize { @open_loggers.dup }
+                loggers.each(&:stop)
+            end
+        end
+    end
+end
@@ -74,6 +74,10 @@ def client(remote_addr)
                               default: Server::DEFAULT_SAMPLING_PERIOD,
                               desc: "period in seconds at which the server "\
                                     "should poll the log file"
+            option :max_client_backlog,
+                   type: :numeric,
+                   desc: "amount of data, in MB, queued for a client above which "\
+                         "the server skips ahead and sends a snapshot of the plan"
             def server(path, port: options[:port])
                 # NOTE: the 'port' argument is here so that it can be overriden
                 # in {#backward}
@@ -93,8 +97,12 @@ def server(path, port: options[:port])
                         end
                 end
 
+                if (max_client_backlog = options[:max_client_backlog])
+                    max_client_backlog = Integer(max_client_backlog * 1024**2)
+                end
                 server = Roby::DRoby::Logfile::Server.new(
-                    path, options[:sampling], server_io
+                    path, options[:sampling], server_io,
+                    max_client_backlog: max_client_backlog
                 )
                 port = server_io.local_address.ip_port
                 Server.info "Roby log server listening on port #{port}, "\
@@ -180,6 +180,7 @@ def stats(file = nil)
                     12_live_object_count
                     13_oob_removed
                     14_gc_total_time
+                    15_poll_count 16_poll_time
                 }
                 # rubocop:disable Lint/NestedPercentLiteral
                 # Starts at 1_cycle_index. 0_actual_start is formatted with strftime
@@ -192,6 +193,7 @@ def stats(file = nil)
                     %i
                     %i
                     %.3f
+                    %i %.3f
                 }
                 # rubocop:enable Lint/NestedPercentLiteral
                 formatting = formatting.join(",")
@@ -217,7 +219,8 @@ def stats(file = nil)
                             ),
                             gc[:total_allocated_objects] - gc[:total_freed_objects],
                             gc[:total_freed_objects] - oob_gc[:total_freed_objects],
-                            info[:gc_total_time] || 0
+                            info[:gc_total_time] || 0,
+                            info[:poll_count] || 0, info[:poll_time] || 0
                         )
 
                     line = (start + info[:actual_start]).strftime("%H:%M:%S.%3N") + " " +
@@ -229,6 +232,39 @@ def stats(file = nil)
                 exit(0)
             end
 
+            desc "replay-bench", "replay the plan operations from a log file "\
+                                 "in a fresh plan, and time them"
+            option :cycles,
+                   type: :numeric,
+                   desc: "only replay this many cycles from the beginning of the log"
+            option :save, type: :string, desc: "file to save the CSV data to"
+            def replay_bench(file = nil)
+                file = handle_file_argument(file)
+
+                require "roby/droby/logfile/reader"
+                require "roby/droby/plan_replay_benchmark"
+
+                stream = Roby::DRoby::Logfile::Reader.open(file)
+                benchmark = Roby::DRoby::PlanReplayBenchmark.new
+                start = Time.now
+                timings = benchmark.replay(stream, max_cycles: options[:cycles])
+                puts format("replayed %<cycles>i cycles in %<duration>.3fs",
+                            cycles: benchmark.cycle_count, duration: Time.now - start)
+
+                io = STDOUT
+                io = File.open(options[:save], "w") if options[:save]
+
+                io.puts "operation,count,total_s,average_us,max_us,errors"
+                timings.sort_by { |_, t| -t.total }.each do |operation, t|
+                    io.puts format("%s,%i,%.3f,%.1f,%.1f,%i",
+                                   operation, t.count, t.total,
+                                   t.average * 1e6, t.max * 1e6, t.errors)
+                end
+            ensure
+                io&.close if options[:save]
+                stream&.close
+            end
+
             desc "decode", "show the raw events from the logfile"
             option :replay,
                    type: :string, default: "normal",
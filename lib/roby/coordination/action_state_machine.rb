@@ -20,9 +20,20 @@ class ActionStateMachine < Actions
 
             StateInfo = Struct.new :required_tasks, :forwards, :transitions, :captures
 
+            # A state that has been prepared ahead of time
+            #
+            # @see Models::ActionStateMachine#prepare_ahead
+            PreparedState = Struct.new :transaction, :variables, :tasks
+
+            # The states that have been prepared ahead of time
+            #
+            # @return [Hash<Coordination::Task,PreparedState>]
+            attr_reader :prepared_states
+
             def initialize(root_task, arguments = {})
                 super(root_task, arguments)
                 @task_info = resolve_state_info
+                @prepared_states = {}
 
                 start_state = model.starting_state
                 if arguments[:start_state]
@@ -50,6 +61,9 @@ def initialize(root_task, arguments = {})
                         instanciate_state(instance_for(start_state))
                     end
                 end
+                root_task.stop_event.on do |_|
+                    discard_prepared_states
+                end
             end
 
             def resolve_state_info
@@ -84,9 +98,13 @@ def dependency_options_for(toplevel, task, roles)
                 options
             end
 
-            def instanciate_state(state)
+            def instanciate_state(state, prepared_tasks: {})
                 begin
-                    start_task(state)
+                    if prepared_tasks.empty?
+                        start_task(state)
+                    else
+                        start_task(state, prepared_tasks: prepared_tasks)
+                    end
                 rescue Models::Capture::Unbound => e
                     raise e, "in the action state machine #{model} running on #{root_task} while starting #{state.name}, #{e.message}", e.backtrace
                 end
@@ -119,15 +137,118 @@ def instanciate_state(state)
                         end
                     end
                 end
+
+                schedule_state_preparation(known_transitions.map(&:last))
             end
 
             def instanciate_state_transition(task, new_state)
                 remove_current_task
+                prepared_tasks = commit_prepared_state(new_state)
                 begin
-                    instanciate_state(new_state)
+                    instanciate_state(new_state, prepared_tasks: prepared_tasks)
                 end
                 run_hook :on_transition, task, new_state
             end
+
+            # @api private
+            #
+            # Registers the preparation of the given states to be done during
+            # the engine's idle time
+            #
+            # States that have not been declared with
+            # {Models::ActionStateMachine#prepare_ahead} are ignored
+            def schedule_state_preparation(states)
+                states = states.uniq.find_all do |s|
+                    model.speculative_state?(s.model)
+                end
+                return if states.empty?
+
+                root_task.execution_engine.add_side_work_handler(
+                    description: "speculative preparation of #{states.map(&:name).join(', ')}",
+                    once: true
+                ) do
+                    states.each { |s| prepare_state_or_warn(s) } if root_task.running?
+                end
+            end
+
+            # @api private
+            #
+            # Calls {#prepare_state}, logging the errors instead of raising
+            #
+            # A state whose preparation failed is instanciated normally when
+            # the transition is taken
+            def prepare_state_or_warn(state)
+                prepare_state(state)
+            rescue Exception => e # rubocop:disable Lint/RescueException
+                Roby.warn "failed to prepare the state #{state.name} of #{root_task} "\
+                          "ahead of time, it will be instanciated when needed"
+                Roby.log_exception_with_backtrace(e, Roby, :warn)
+                nil
+            end
+
+            # Instanciates the actions of the given state in a transaction
+            #
+            # The transaction is committed by {#commit_prepared_state} when the
+            # machine transitions to this state, and discarded otherwise
+            #
+            # @return [PreparedState,nil] the preparation, or nil if the state
+            #   has no task that can be prepared
+            def prepare_state(state)
+                if (prepared = prepared_states[state])
+                    return prepared
+                end
+
+                variables = arguments.merge(resolved_captures)
+                transaction = Transaction.new(root_task.plan)
+                tasks = {}
+                task_info[state].required_tasks.each do |task, _|
+                    if (result = task.model.prepare_instanciation(transaction, variables))
+                        tasks[task] = result
+                    end
+                end
+
+                if tasks.empty?
+                    transaction.discard_transaction
+                    return
+                end
+
+                prepared_states[state] =
+                    PreparedState.new(transaction, variables, tasks)
+            rescue Exception # rubocop:disable Lint/RescueException
+                transaction&.discard_transaction
+                raise
+            end
+
+            # @api private
+            #
+            # Commits the preparation of the given state, if there is one, and
+            # discards the others
+            #
+            # @return [Hash<Coordination::Task,Roby::Task>] the prepared tasks
+            #   that are now in the plan
+            def commit_prepared_state(state)
+                prepared = prepared_states.delete(state)
+                discard_prepared_states
+                return {} unless prepared
+
+                transaction = prepared.transaction
+                variables = arguments.merge(resolved_captures)
+                if transaction.invalid? || prepared.variables != variables
+                    transaction.discard_transaction
+                    return {}
+                end
+
+                transaction.commit_transaction
+                prepared.tasks
+            end
+
+            # Discards all the states prepared ahead of time
+            def discard_prepared_states
+                prepared_states.each_value do |prepared|
+                    prepared.transaction.discard_transaction
+                end
+                prepared_states.clear
+            end
         end
     end
 end
@@ -67,13 +67,18 @@ def dependency_options_for(toplevel, task, roles)
                      remove_when_done: true]
             end
 
-            def start_task(toplevel, explicit_start: false)
+            # @param [Hash<Coordination::Task,Roby::Task>] prepared_tasks
+            #   tasks that have already been instanciated in the plan, and
+            #   should be used instead of instanciating the tasks' models
+            def start_task(toplevel, explicit_start: false, prepared_tasks: {})
                 task_info = self.task_info[toplevel]
                 tasks, forwards = task_info.required_tasks, task_info.forwards
                 variables = arguments.merge(resolved_captures)
 
                 instanciated_tasks = tasks.map do |task, roles|
-                    action_task = task.model.instanciate(root_task.plan, variables)
+                    action_task =
+                        prepared_tasks[task] ||
+                        task.model.instanciate(root_task.plan, variables)
                     root_task.depends_on(action_task, dependency_options_for(toplevel, task, roles))
                     bind_coordination_task_to_instance(task, action_task, on_replace: :copy)
                     task.model.setup_instanciated_task(self, action_task, variables)
@@ -64,6 +64,12 @@ module ActionStateMachine
                 # @return [Array<(Task,Event,Task)>]
                 inherited_attribute(:transition, :transitions) { [] }
 
+                # The set of states that should be prepared ahead of time
+                #
+                # @return [Array<Task>]
+                # @see prepare_ahead
+                inherited_attribute(:speculative_state, :speculative_states) { [] }
+
                 # (see Actions#toplevel_state?)
                 def toplevel_state?(state)
                     root == state ||
@@ -81,6 +87,7 @@ def map_tasks(mapping)
                          mapping[event.task].find_event(event.symbol),
                          mapping[new_state]]
                     end
+                    @speculative_states = speculative_states.map { |s| mapping[s] }
                 end
 
                 def parse_names
@@ -136,6 +143,47 @@ def capture(state, event = nil, &block)
                     capture
                 end
 
+                # Declares that the given states should be prepared ahead of time
+                #
+                # When the state machine enters a state that has transitions
+                # towards one of these states, the actions of the target states
+                # get instanciated into a transaction during the engine's idle
+                # time (see {ExecutionEngine#add_side_work_handler}). The
+                # transaction is committed when the transition is taken, and
+                # discarded when another transition is taken.
+                #
+                # Only the tasks that are created from actions are prepared. The
+                # preparation is also discarded if the captures the state's
+                # arguments depend on have changed in between.
+                #
+                # Note that a prepared state has a different plan structure
+                # than a state that is not prepared. The action is planned
+                # directly (see {TaskFromAction#prepare_instanciation}), so
+                # the state's task is the planned task itself instead of a
+                # placeholder with an action planning task. Code that expects
+                # the state's task to have a planning task must not be used
+                # on prepared states. Errors raised during the preparation
+                # are logged, and the state is then instanciated normally.
+                #
+                # @example prepare the 'approach' state while in 'search'
+                #   search   = state search_for_target
+                #   approach = state approach_target
+                #   start search
+                #   transition search.success_event, approach
+                #   prepare_ahead approach
+                def prepare_ahead(*states)
+                    states.each do |s|
+                        speculative_states << validate_task(s)
+                    end
+                end
+
+                # Whether the given state should be prepared ahead of time
+                #
+                # @see prepare_ahead
+                def speculative_state?(state)
+                    each_speculative_state.any? { |s| s == state }
+                end
+
                 # Returns the state for the given name, if found, nil otherwise
                 #
                 # @return Roby::Coordination::Models::TaskFromAction
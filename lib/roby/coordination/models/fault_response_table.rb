@@ -14,7 +14,11 @@ module FaultResponseTable
                 inherited_attribute("fault_handler", "fault_handlers") { [] }
 
                 def find_all_matching_handlers(exception)
-                    each_fault_handler.find_all do |h|
+                    @fault_handler_index ||= ExceptionHandlerIndex.new
+                    candidates = @fault_handler_index.candidates(
+                        exception, each_fault_handler
+                    ) { |h| h.execution_exception_matcher }
+                    candidates.find_all do |h|
                         h.execution_exception_matcher === exception
                     end
                 end
@@ -47,6 +51,7 @@ def on_fault(exception_matcher, &block)
                         create_coordination_action(action_model, Coordination::FaultHandler, &block)
                     handler.execution_exception_matcher(exception_matcher)
                     fault_handlers << handler
+                    ExceptionHandlerIndex.invalidate
                     handler
                 end
 
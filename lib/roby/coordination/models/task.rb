@@ -177,6 +177,18 @@ def instanciate(plan, variables = {})
                 end
 
                 def setup_instanciated_task(coordination_context, task, arguments = {}); end
+
+                # Instanciate this task ahead of time in a transaction
+                #
+                # This is used by {ActionStateMachine#prepare_ahead}. Tasks
+                # that cannot be prepared return nil, and are instanciated with
+                # {#instanciate} when needed.
+                #
+                # @param [Transaction] transaction
+                # @param [Hash] variables the value of the coordination
+                #   variables
+                # @return [Roby::Task,nil]
+                def prepare_instanciation(transaction, variables = {}); end
             end
         end
     end
@@ -25,13 +25,32 @@ def rebind(coordination_model)
                 # Generates a task for this state in the given plan and returns
                 # it
                 def instanciate(plan, variables = {})
-                    arguments = action.arguments.transform_values do |value|
+                    action.as_plan(**evaluate_arguments(variables))
+                end
+
+                # Runs the action in the given transaction
+                #
+                # Unlike {#instanciate}, the action is actually planned instead
+                # of being represented by a placeholder task with an
+                # {Actions::Task} planning task. The plan structure of a
+                # prepared state therefore differs from the one of a normally
+                # instanciated state: the state's task is the planned task and
+                # has no planning task.
+                def prepare_instanciation(transaction, variables = {})
+                    action.instanciate(transaction, **evaluate_arguments(variables))
+                end
+
+                # @api private
+                #
+                # Resolves the action arguments that depend on coordination
+                # variables
+                def evaluate_arguments(variables)
+                    action.arguments.transform_values do |value|
                         if value.respond_to?(:evaluate)
                             value.evaluate(variables)
                         else value
                         end
                     end
-                    action.as_plan(**arguments)
                 end
 
                 # Returns the action's underlying coordination model if there is one
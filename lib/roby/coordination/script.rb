@@ -109,8 +109,13 @@ def initialize(model, event)
                     @event = event
                 end
 
+                def cancel
+                    @timer&.dispose
+                    super
+                end
+
                 def execute(script)
-                    script.root_task.execution_engine.delayed(model.seconds) do
+                    @timer = script.root_task.execution_engine.delayed(model.seconds) do
                         unless disabled?
                             # Remove all instructions that are within the
                             # timeout's scope
@@ -112,6 +112,26 @@ def close
                 logfile.close
             end
 
+            # Close this logger, moving the messages of the cycle that is
+            # being built to another logger
+            #
+            # It is used to switch loggers in the middle of a cycle. The
+            # messages must not refer to plan objects, as these are not
+            # known to the new logger.
+            #
+            # @param [EventLogger] logger
+            def close_into(logger)
+                pending = synchronize do
+                    cycle = @current_cycle
+                    @current_cycle = []
+                    cycle
+                end
+                logger.synchronize do
+                    logger.current_cycle.unshift(*pending)
+                end
+                close
+            end
+
             def append_message(m, time, args)
                 if m == :merged_plan
                     plan_id, merged_plan = *args
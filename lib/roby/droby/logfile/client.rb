@@ -35,6 +35,18 @@ class Client
                 #   @return [void]
                 define_hooks :on_data
 
+                # @!method on_resync
+                #   Hooks called when the server skipped part of the log
+                #   because this client was lagging behind
+                #
+                #   The next cycle is a snapshot of the plan (see
+                #   {SnapshotBuilder}). Listeners must discard the state they
+                #   built so far, e.g. by calling {PlanRebuilder#clear}
+                #
+                #   @yieldparam [Integer] skipped the amount of bytes skipped
+                #   @return [void]
+                define_hooks :on_resync
+
                 # @!endgroup
 
                 # The socket through which we are connected to the remote host
@@ -48,6 +60,12 @@ class Client
                 attr_reader :buffer
                 # The amount of bytes received so far
                 attr_reader :rx
+                # The amount of bytes that the server skipped so far
+                attr_reader :skipped
+                # The logging time of the end of the last cycle received
+                #
+                # @return [Time,nil]
+                attr_reader :last_cycle_time
 
                 def initialize(host, port = Server::DEFAULT_PORT)
                     @host = host
@@ -55,6 +73,8 @@ def initialize(host, port = Server::DEFAULT_PORT)
                     @buffer = String.new
 
                     @rx = 0
+                    @skipped = 0
+                    @last_cycle_time = nil
                     @socket =
                         begin TCPSocket.new(host, port)
                         rescue Errno::ECONNREFUSED, Errno::EADDRNOTAVAIL => e
@@ -103,6 +123,17 @@ def read_and_process_pending(max: 0)
                     processed_one_cycle
                 end
 
+                # How late the data received so far is
+                #
+                # It is the time between the end of the last received cycle and
+                # now
+                #
+                # @return [Float,nil] the lag in seconds, or nil if no cycle has
+                #   been received yet
+                def lag(now = Time.now)
+                    now - last_cycle_time if last_cycle_time
+                end
+
                 # The number of bytes that have to be transferred to finish
                 # initializing the connection
                 attr_reader :init_size
@@ -160,8 +191,16 @@ def read_and_process_one_pending_cycle
                             run_hook :on_init_done
                         elsif data[0] == Server::CONNECTION_INIT
                             @init_size = data[1]
+                        elsif data[0] == Server::CONNECTION_RESYNC
+                            Logfile.info "log server skipped #{data[1]} bytes "\
+                                         "and sent a snapshot"
+                            @skipped += data[1]
+                            run_hook :on_resync, data[1]
                         else
                             @rx += (data_size + 4)
+                            if data[-4] == :cycle_end
+                                @last_cycle_time = Time.at(data[-3], data[-2])
+                            end
                             unless init_done?
                                 run_hook :on_init_progress, rx, init_size
                             end
@@ -16,6 +16,14 @@ module Logfile
             # it.
             #
             # When a client connects, it will send the complete file
+            #
+            # If a maximum client backlog is set, the server maintains the plan
+            # described by the log (see {SnapshotBuilder}). Clients whose
+            # backlog grows over the limit are sent a {CONNECTION_RESYNC} message
+            # followed by a snapshot of the current plan, instead of the data
+            # they are lagging behind. Clients that connect while the log is
+            # bigger than the limit get the snapshot instead of the complete
+            # file.
             class Server
                 extend Logger::Hierarchy
                 make_own_logger("Log Server", Logger::WARN)
@@ -37,13 +45,39 @@ class Server
                 attr_reader :pending_data
                 # The server socket
                 attr_reader :server
+                # The maximum amount of bytes queued for a client before it
+                # gets resynchronized on a snapshot. Nil if the clients are
+                # never resynchronized
+                #
+                # @return [Integer,nil]
+                attr_reader :max_client_backlog
+                # The object that builds the snapshots sent to the clients that
+                # are resynchronized
+                #
+                # @return [SnapshotBuilder,nil]
+                attr_reader :snapshot_builder
 
-                def initialize(event_file_path, sampling_period, io)
+                def initialize(event_file_path, sampling_period, io,
+                               max_client_backlog: nil)
                     @server = io
                     @pending_data = {}
+                    @partial_heads = Set.new
                     @sampling_period = sampling_period
                     @event_file_path = event_file_path
                     @event_file = File.open(event_file_path, "r:BINARY")
+                    @incomplete_block = String.new
+                    @max_client_backlog = max_client_backlog
+                    if max_client_backlog
+                        require "roby/droby/logfile/snapshot_builder"
+                        @snapshot_builder = SnapshotBuilder.new
+                    end
+                    @connection_init_done =
+                        Server.block(::Marshal.dump(CONNECTION_INIT_DONE)).freeze
+                end
+
+                # Prefix some data with its size, to form a log block
+                def self.block(data)
+                    [data.size].pack("L<") + data
                 end
 
                 def found_header?
@@ -66,6 +100,7 @@ def close
                 def close_client_connections
                     @pending_data.each_key(&:close)
                     @pending_data.clear
+                    @partial_heads.clear
                 end
 
                 def exec
@@ -88,22 +123,7 @@ def exec
                             socket.fcntl(Fcntl::FD_CLOEXEC, 1)
 
                             Server.debug "new connection: #{socket}"
-                            if found_header?
-                                all_data = File.binread(event_file_path,
-                                                        event_file.tell - Logfile::PROLOGUE_SIZE,
-                                                        Logfile::PROLOGUE_SIZE)
-
-                                Server.debug "  queueing #{all_data.size} bytes of data"
-                                chunks = split_in_chunks(all_data)
-                            else
-                                Server.debug "  log file is empty, not queueing any data"
-                                chunks = []
-                            end
-                            connection_init      = ::Marshal.dump([CONNECTION_INIT, chunks.inject(0) { |s, c| s + c.size }])
-                            connection_init_done = ::Marshal.dump(CONNECTION_INIT_DONE)
-                            chunks.unshift([connection_init.size].pack("L<") + connection_init)
-                            chunks << [connection_init_done.size].pack("L<") + connection_init_done
-                            @pending_data[socket] = chunks
+                            @pending_data[socket] = connection_init_data
                         end
 
                         # Read new data
@@ -116,26 +136,93 @@ def exec
                     raise
                 end
 
-                # Splits the data block in +data+ in blocks of size DATA_CHUNK_SIZE
+                # @api private
+                #
+                # The data that should be sent to a new client
+                #
+                # @return [Array<String>]
+                def connection_init_data
+                    log_size = event_file.tell - Logfile::PROLOGUE_SIZE -
+                               @incomplete_block.size
+                    if !found_header?
+                        Server.debug "  log file is empty, not queueing any data"
+                        chunks = []
+                    elsif resync_on_connection?(log_size)
+                        Server.debug "  log file is bigger than the maximum client "\
+                                     "backlog, queueing a snapshot"
+                        chunks = [Server.block(::Marshal.dump(snapshot_builder.snapshot))]
+                    else
+                        all_data = File.binread(event_file_path, log_size,
+                                                Logfile::PROLOGUE_SIZE)
+                        Server.debug "  queueing #{all_data.size} bytes of data"
+                        chunks = split_in_chunks(all_data)
+                    end
+                    init_size = chunks.inject(0) { |s, c| s + c.size }
+                    connection_init = ::Marshal.dump([CONNECTION_INIT, init_size])
+                    chunks.unshift(Server.block(connection_init).freeze)
+                    chunks << @connection_init_done
+                end
+
+                # @api private
+                #
+                # Whether a new client should get a snapshot instead of the
+                # complete log
+                def resync_on_connection?(log_size)
+                    max_client_backlog && log_size > max_client_backlog &&
+                        snapshot_builder.available?
+                end
+
+                # Splits the data block in +data+ in chunks of at most
+                # DATA_CHUNK_SIZE
+                #
+                # Chunks are split at the log block boundaries, so that a
+                # chunk is made of complete blocks (which may be bigger than
+                # DATA_CHUNK_SIZE if a single block is). Data after the last
+                # complete block is ignored, see {.complete_blocks_size}
                 def split_in_chunks(data)
                     result = []
 
                     index = 0
-                    while index != data.size
-                        remaining = (data.size - index)
-                        if remaining > DATA_CHUNK_SIZE
-                            result << data[index, DATA_CHUNK_SIZE]
-                            index += DATA_CHUNK_SIZE
-                        else
-                            result << data[index, remaining]
-                            index = data.size
+                    chunk_start = 0
+                    while (block_end = Server.next_block_end(data, index))
+                        if block_end - chunk_start > DATA_CHUNK_SIZE && index != chunk_start
+                            result << data[chunk_start, index - chunk_start]
+                            chunk_start = index
                         end
+                        index = block_end
                     end
+                    result << data[chunk_start, index - chunk_start] if index != chunk_start
                     result
                 end
 
+                # @api private
+                #
+                # The end of the block that starts at the given position
+                #
+                # @return [Integer,nil] the end position, or nil if the data
+                #   does not contain the whole block
+                def self.next_block_end(data, index)
+                    return if data.size < index + 4
+
+                    block_end = index + 4 + data[index, 4].unpack1("L<")
+                    block_end if block_end <= data.size
+                end
+
+                # The size of the data at the beginning of +data+ that is made
+                # of complete blocks
+                def self.complete_blocks_size(data)
+                    index = 0
+                    while (block_end = next_block_end(data, index))
+                        index = block_end
+                    end
+                    index
+                end
+
                 # Reads new data from the underlying file and queues it to dispatch
                 # for our clients
+                #
+                # Only complete blocks are queued, the rest is kept until the
+                # next call
                 def read_new_data
                     new_data = event_file.read
                     return if new_data.empty?
@@ -154,16 +241,58 @@ def read_new_data
                         end
                     end
 
+                    @incomplete_block.concat(new_data)
+                    size = Server.complete_blocks_size(@incomplete_block)
+                    return if size == 0
+
+                    new_data = @incomplete_block[0, size]
+                    @incomplete_block = @incomplete_block[size..-1]
+                    snapshot_builder&.process_blocks(new_data)
+
                     # Split the data in chunks of DATA_CHUNK_SIZE, and add the
                     # chunks in the pending_data hash
                     new_chunks = split_in_chunks(new_data)
-                    pending_data.each_value do |chunks|
+                    pending_data.each do |socket, chunks|
                         chunks.concat(new_chunks)
+                        resync_if_lagging(socket, chunks)
                     end
                 end
 
+                # @api private
+                #
+                # Replace the data queued for a client by a snapshot if its
+                # backlog is over {#max_client_backlog}
+                def resync_if_lagging(socket, chunks)
+                    return unless max_client_backlog
+
+                    backlog = chunks.inject(0) { |s, c| s + c.size }
+                    return if backlog <= max_client_backlog
+                    return unless snapshot_builder.available?
+
+                    # A partially sent chunk must be sent completely to keep
+                    # the stream consistent
+                    kept = @partial_heads.include?(socket) ? [chunks.shift] : []
+                    # The connection init messages are the only frozen chunks,
+                    # they must be kept
+                    control, data = chunks.partition(&:frozen?)
+                    init, init_done =
+                        control.partition { |c| !c.equal?(@connection_init_done) }
+                    skipped = data.inject(0) { |s, c| s + c.size }
+                    Server.info "#{socket} has a backlog of #{backlog} bytes, "\
+                                "resynchronizing (skipping #{skipped} bytes)"
+
+                    chunks.replace(kept + init)
+                    chunks << Server.block(::Marshal.dump([CONNECTION_RESYNC, skipped]))
+                    chunks << Server.block(::Marshal.dump(snapshot_builder.snapshot))
+                    chunks.concat(init_done)
+                end
+
                 CONNECTION_INIT = :log_server_connection_init
                 CONNECTION_INIT_DONE = :log_server_connection_init_done
+                # Message sent before a snapshot cycle, when the data between
+                # the last sent cycle and the snapshot has been skipped. It is
+                # sent as [CONNECTION_RESYNC, skipped_bytes]
+                CONNECTION_RESYNC = :log_server_connection_resync
 
                 # Tries to send all pending data to the connected clients
                 def send_pending_data
@@ -176,9 +305,14 @@ def send_pending_data
                                 next
                             end
 
+                            # The chunks are shared between the clients, do not
+                            # modify them
                             buffer = chunks.shift
-                            while !chunks.empty? && (buffer.size + chunks[0].size < DATA_CHUNK_SIZE)
-                                buffer.concat(chunks.shift)
+                            if !chunks.empty? && (buffer.size + chunks[0].size < DATA_CHUNK_SIZE)
+                                buffer = buffer.dup
+                                while !chunks.empty? && (buffer.size + chunks[0].size < DATA_CHUNK_SIZE)
+                                    buffer.concat(chunks.shift)
+                                end
                             end
                             Server.debug "sending #{buffer.size} bytes to #{socket}"
 
@@ -194,18 +328,21 @@ def send_pending_data
                                     Server.warn "  #{line}"
                                 end
                                 socket.close
+                                @partial_heads.delete(socket)
                                 next(true)
                             end
 
                             remaining = buffer.size - written
                             if remaining == 0
                                 Server.debug "wrote complete chunk of #{written} bytes to #{socket}"
+                                @partial_heads.delete(socket)
                                 # Loop if we wrote the complete chunk and there
                                 # is still stuff to write for this socket
                                 needs_looping = !chunks.empty?
                             else
                                 Server.debug "wrote partial chunk #{written} bytes instead of #{buffer.size} bytes to #{socket}"
                                 chunks.unshift(buffer[written, remaining])
+                                @partial_heads << socket
                             end
                             false
                         end
@@ -0,0 +1,90 @@
+# frozen_string_literal: true
+
+require "roby/droby/plan_rebuilder"
+
+module Roby
+    module DRoby
+        module Logfile
+            # Maintains the plan described by a log stream, to synthesize a
+            # cycle from which a client can resume the stream
+            #
+            # This is used by {Server} to let clients that fall behind skip
+            # part of the stream. The synthesized cycle registers the executable
+            # plan and merges the whole current plan in it, including the
+            # relations, the mission and permanent flags and the task states.
+            # The event history is not part of it.
+            #
+            # The plan objects keep the IDs they have in the log stream, so that
+            # the client can process the rest of the stream after the snapshot.
+            class SnapshotBuilder
+                # The rebuilder that maintains the plan
+                #
+                # @return [PlanRebuilder]
+                attr_reader :rebuilder
+
+                # The ID of the executable plan in the log stream
+                attr_reader :plan_id
+
+                def initialize
+                    @rebuilder = PlanRebuilder.new
+                    @plan_id = nil
+                    @snapshot = nil
+                end
+
+                # Whether enough of the stream has been processed to
+                # synthesize a snapshot
+                def available?
+                    plan_id && rebuilder.stats[:start]
+                end
+
+                # Process data blocks as they appear in the log stream
+                #
+                # @param [String] data a sequence of complete blocks, i.e. a
+                #   size as a 32-bit little-endian integer followed by the
+                #   block data
+                def process_blocks(data)
+                    io = StringIO.new(data)
+                    while (chunk = Logfile.read_one_chunk(io))
+                        process_cycle(Logfile.decode_one_chunk(chunk))
+                    end
+                end
+
+                # Process one unmarshalled block
+                def process_cycle(data)
+                    # The first block of the stream is the log options
+                    return if data.kind_of?(Hash)
+
+                    data.each_slice(4) do |m, _, _, args|
+                        @plan_id = args.first if m == :register_executable_plan
+                    end
+                    rebuilder.process_one_cycle(data)
+                    rebuilder.clear_integrated
+                    @snapshot = nil
+                end
+
+                # The cycle data that recreates the current plan
+                #
+                # @return [Array] a flat list of (message, sec, usec, args)
+                #   tuples, as in the log stream
+                def snapshot
+                    @snapshot ||= build_snapshot
+                end
+
+                # @api private
+                def build_snapshot
+                    marshal = Marshal.new(rebuilder.object_manager, nil)
+                    sec, usec = rebuilder.stats[:start]
+                    # The plan must be dumped explicitely, as the marshaller
+                    # would only dump its ID
+                    plan = rebuilder.plan.droby_dump(marshal)
+                    stats = rebuilder.stats.merge(state: rebuilder.state)
+                    [
+                        :register_executable_plan, sec, usec, [plan_id],
+                        :merged_plan, sec, usec, [plan_id, plan],
+                        :cycle_end, sec, usec, [stats]
+                    ]
+                end
+            end
+        end
+    end
+end
@@ -0,0 +1,105 @@
+# frozen_string_literal: true
+
+module Roby
+    module DRoby
+        # The structural changes done on a rebuilt plan over a period of time
+        #
+        # {PlanRebuilder} records the changes of each cycle in
+        # {PlanRebuilder#change_set}. Displays accumulate them with {#merge},
+        # to find out what they have to update instead of comparing the
+        # whole plan with their previous state.
+        #
+        # A change set can be marked as {#full?}, meaning that the changes are
+        # not known (e.g. because the rebuilder has been cleared, or because
+        # the display jumped to a non-consecutive point in the history). In
+        # this case, the consumers must assume that everything changed.
+        class PlanChangeSet
+            # The tasks and events that have been added to the plan
+            #
+            # @return [Set<PlanObject>]
+            attr_reader :added_objects
+            # The tasks and events that have been finalized
+            #
+            # @return [Set<PlanObject>]
+            attr_reader :removed_objects
+            # The relations that have been added, as (parent, child, relation)
+            # tuples
+            #
+            # @return [Set<(PlanObject,PlanObject,Class)>]
+            attr_reader :added_edges
+            # The relations that have been removed, as (parent, child,
+            # relation) tuples
+            #
+            # @return [Set<(PlanObject,PlanObject,Class)>]
+            attr_reader :removed_edges
+            # The tasks and events whose status changed, i.e. their
+            # mission/permanent status, their arguments or their
+            # execution state
+            #
+            # @return [Set<PlanObject>]
+            attr_reader :changed_objects
+
+            # Creates a change set that is marked as {#full?}
+            def self.full
+                new.full!
+            end
+
+            def initialize
+                @full = false
+                @added_objects = Set.new
+                @removed_objects = Set.new
+                @added_edges = Set.new
+                @removed_edges = Set.new
+                @changed_objects = Set.new
+            end
+
+            # Whether the changes are unknown, and everything should be
+            # assumed to have changed
+            def full?
+                @full
+            end
+
+            # Marks this change set as {#full?}
+            #
+            # @return [self]
+            def full!
+                @full = true
+                self
+            end
+
+            # Whether nothing changed
+            def empty?
+                !full? &&
+                    added_objects.empty? && removed_objects.empty? &&
+                    added_edges.empty? && removed_edges.empty? &&
+                    changed_objects.empty?
+            end
+
+            # Adds the changes of another change set to this one
+            #
+            # @param [PlanChangeSet] other
+            # @return [self]
+            def merge(other)
+                @full ||= other.full?
+                added_objects.merge(other.added_objects)
+                removed_objects.merge(other.removed_objects)
+                added_edges.merge(other.added_edges)
+                removed_edges.merge(other.removed_edges)
+                changed_objects.merge(other.changed_objects)
+                self
+            end
+
+            # Enumerates the added and removed relations
+            #
+            # @yieldparam [PlanObject] parent
+            # @yieldparam [PlanObject] child
+            # @yieldparam [Class] relation
+            def each_changed_edge(&block)
+                return enum_for(__method__) unless block_given?
+
+                added_edges.each(&block)
+                removed_edges.each(&block)
+            end
+        end
+    end
+end
@@ -1,6 +1,7 @@
 # frozen_string_literal: true
 
 require "roby/droby/rebuilt_plan"
+require "roby/droby/plan_change_set"
 
 module Roby
     module DRoby
@@ -30,6 +31,11 @@ class PlanRebuilder
             # Don't manipulate directly, but use the announce_* and
             # has_*_changes? methods
             attr_reader :changes
+            # The structural changes done on the plan since the last call to
+            # #clear_integrated
+            #
+            # @return [PlanChangeSet]
+            attr_reader :change_set
             # A set of EventFilter objects that list the labelling objects /
             # filters applied on the event stream
             attr_reader :event_filters
@@ -100,6 +106,7 @@ def clear
                 plan.clear
                 object_manager.clear
                 @scheduler_state = Schedulers::State.new
+                change_set.full!
             end
 
             # Processes one cycle worth of data coming from an EventStream,
@@ -155,6 +162,7 @@ def clear_changes
                     state: false,
                     structure: false,
                     event_propagation: false]
+                @change_set = PlanChangeSet.new
             end
 
             def self.update_type(type)
@@ -181,6 +189,7 @@ def self.update_type(type)
             def register_executable_plan(time, plan_id)
                 @plan = RebuiltPlan.new
                 object_manager.register_object(plan, nil => plan_id)
+                change_set.full!
                 @plan
             end
 
@@ -196,6 +205,7 @@ def merged_plan(time, plan_id, merged_plan)
                 tasks_and_events.each do |obj|
                     obj.addition_time = time
                 end
+                change_set.added_objects.merge(tasks_and_events)
                 [plan, merged_plan]
             end
 
@@ -206,6 +216,7 @@ def added_edge(time, parent, child, relations, info)
                 info   = local_object(info)
                 g = parent.relation_graph_for(rel)
                 g.add_edge(parent, child, info)
+                change_set.added_edges << [parent, child, rel]
                 [parent, child, rel, info]
             end
 
@@ -225,9 +236,21 @@ def removed_edge(time, parent, child, relations)
                 rel    = local_object(relations.first)
                 g = parent.relation_graph_for(rel)
                 g.remove_edge(parent, child)
+                change_set.removed_edges << [parent, child, rel]
                 [parent, child, rel]
             end
 
+            # Relation changes logged as a group by
+            # {ExecutablePlan#group_edge_changes}
+            #
+            # @param [Array] changes a list of (message, *args) tuples, where
+            #   message is one of added_edge, removed_edge or updated_edge_info
+            def grouped_edge_changes(time, changes)
+                changes.map do |m, *args|
+                    send(m, time, *args)
+                end
+            end
+
             def task_status_change(time, task, status)
                 task = local_object(task)
                 if status == :normal
@@ -238,6 +261,7 @@ def task_status_change(time, task, status)
                 elsif status == :mission
                     plan.add_mission_task(task)
                 end
+                change_set.changed_objects << task
                 task
             end
 
@@ -248,6 +272,7 @@ def event_status_change(time, event, status)
                 elsif status == :permanent
                     plan.add_permanent_event(event)
                 end
+                change_set.changed_objects << event
                 event
             end
 
@@ -276,6 +301,7 @@ def finalized_event(time, plan_id, event)
                     plan.remove_free_event(event)
                     announce_structure_update
                 end
+                change_set.removed_objects << event
                 object_manager.deregister_object(event)
                 [plan, event]
             end
@@ -289,6 +315,7 @@ def finalized_task(time, plan_id, task)
                     plan.remove_task(task)
                     announce_structure_update
                 end
+                change_set.removed_objects << task
                 object_manager.deregister_object(task)
                 [plan, task]
             end
@@ -297,6 +324,7 @@ def task_arguments_updated(time, task, key, value)
                 task  = local_object(task)
                 value = local_object(value)
                 task.arguments.force_merge!(key => value)
+                change_set.changed_objects << task
                 [task, value]
             end
 
@@ -305,6 +333,7 @@ def task_failed_to_start(time, task, reason)
                 reason = local_object(reason)
                 task.plan.failed_to_start << [task, reason]
                 task.mark_failed_to_start(reason, time)
+                change_set.changed_objects << task
                 announce_event_propagation_update
                 [task, reason]
             end
@@ -317,6 +346,9 @@ def generator_fired(time, event)
                 generator.instance_eval { @emitted = true }
                 if generator.respond_to?(:task)
                     generator.task.fired_event(event)
+                    change_set.changed_objects << generator.task
+                else
+                    change_set.changed_objects << generator
                 end
                 generator.plan.emitted_events << event
                 announce_event_propagation_update
@@ -343,6 +375,7 @@ def generator_unreachable(time, generator, reason)
                 generator = local_object(generator)
                 reason    = local_object(reason)
                 generator.mark_unreachable!(reason)
+                change_set.changed_objects << generator
                 [generator, reason]
             end
 
@@ -0,0 +1,251 @@
+# frozen_string_literal: true
+
+require "roby/droby/plan_rebuilder"
+
+module Roby
+    module DRoby
+        # Replays the plan mutations stored in a log file against a fresh
+        # {ExecutablePlan}, timing each class of operation
+        #
+        # Unlike {PlanRebuilder}, which maintains a display-oriented
+        # {RebuiltPlan}, this applies the mutations the way the execution
+        # engine does (plan merges, relation modifications with their hooks,
+        # mission/permanent status changes, task removals, ...). It is meant to
+        # profile the framework on real workloads, and to compare framework
+        # versions offline.
+        #
+        # Tasks are unmarshalled as remote tasks, so the replay has no external
+        # side effects: the execution engine is never started, and neither
+        # the task commands nor the event handlers are called. Event
+        # propagation, exceptions and scheduler reports are ignored, except
+        # for the event emissions, which are added to the generator's
+        # history to keep the task state up to date.
+        #
+        # Only the plan operations are timed, not the unmarshalling of their
+        # arguments. Operations that fail (e.g. because a relation hook raises)
+        # are counted separately in {Timing#errors}.
+        class PlanReplayBenchmark < PlanRebuilder
+            # Timing information about a class of operation
+            #
+            # @!method count
+            #   @return [Integer] how many times the operation has been
+            #     replayed
+            # @!method total
+            #   @return [Float] the total time spent in the operation, in
+            #     seconds
+            # @!method max
+            #   @return [Float] the longest time spent in a single operation,
+            #     in seconds
+            # @!method errors
+            #   @return [Integer] how many times the operation raised
+            Timing = Struct.new :count, :total, :max, :errors do
+                # The average time spent in the operation, in seconds
+                def average
+                    count == 0 ? 0 : total / count
+                end
+            end
+
+            # The timings, per operation
+            #
+            # @return [Hash<Symbol,Timing>]
+            attr_reader :timings
+
+            # How many log cycles have been replayed
+            #
+            # @return [Integer]
+            attr_reader :cycle_count
+
+            def initialize(plan: ExecutablePlan.new)
+                super(plan: plan)
+                @timings = Hash.new { |h, k| h[k] = Timing.new(0, 0.0, 0.0, 0) }
+                @cycle_count = 0
+            end
+
+            # Replay a whole log stream
+            #
+            # @param [Logfile::Reader] stream
+            # @param [Integer,nil] max_cycles if set, stop after this many
+            #   cycles
+            # @return [Hash<Symbol,Timing>]
+            def replay(stream, max_cycles: nil)
+                while (!max_cycles || cycle_count < max_cycles) &&
+                      (data = stream.load_one_cycle)
+                    process_one_cycle(data)
+                    @cycle_count += 1
+                end
+                timings
+            end
+
+            # @api private
+            #
+            # Time the given block as one occurence of the given operation
+            def measure(operation)
+                timing = timings[operation]
+                start = Time.now
+                begin
+                    yield
+                rescue Interrupt
+                    raise
+                rescue StandardError
+                    timing.errors += 1
+                end
+                duration = Time.now - start
+                timing.count += 1
+                timing.total += duration
+                timing.max = duration if duration > timing.max
+                nil
+            end
+
+            # The log's plan is mapped to the plan given at construction time
+            def register_executable_plan(_time, plan_id)
+                object_manager.register_object(plan, nil => plan_id)
+                plan
+            end
+
+            def merged_plan(time, plan_id, merged_plan)
+                merged_plan = local_object(merged_plan)
+                plan = local_object(plan_id)
+                measure(:merged_plan) { plan.merge(merged_plan) }
+                [plan, merged_plan]
+            end
+
+            def added_edge(time, parent, child, relations, info)
+                parent = local_object(parent)
+                child  = local_object(child)
+                rel    = local_object(relations.first)
+                info   = local_object(info)
+                measure(:added_edge) do
+                    parent.relation_graph_for(rel).add_relation(parent, child, info)
+                end
+                [parent, child, rel, info]
+            end
+
+            def updated_edge_info(time, parent, child, relation, info)
+                parent = local_object(parent)
+                child  = local_object(child)
+                rel    = local_object(relation)
+                info   = local_object(info)
+                measure(:updated_edge_info) do
+                    parent.relation_graph_for(rel).set_edge_info(parent, child, info)
+                end
+                [parent, child, rel, info]
+            end
+
+            def removed_edge(time, parent, child, relations)
+                parent = local_object(parent)
+                child  = local_object(child)
+                rel    = local_object(relations.first)
+                measure(:removed_edge) do
+                    parent.relation_graph_for(rel).remove_relation(parent, child)
+                end
+                [parent, child, rel]
+            end
+
+            def task_status_change(time, task, status)
+                task = local_object(task)
+                measure(:task_status_change) do
+                    case status
+                    when :normal
+                        plan.unmark_mission_task(task)
+                        plan.unmark_permanent_task(task)
+                    when :permanent then plan.add_permanent_task(task)
+                    when :mission then plan.add_mission_task(task)
+                    end
+                end
+                task
+            end
+
+            def event_status_change(time, event, status)
+                event = local_object(event)
+                measure(:event_status_change) do
+                    case status
+                    when :normal then plan.unmark_permanent_event(event)
+                    when :permanent then plan.add_permanent_event(event)
+                    end
+                end
+                event
+            end
+
+            def task_arguments_updated(time, task, key, value)
+                task  = local_object(task)
+                value = local_object(value)
+                measure(:task_arguments_updated) do
+                    task.arguments.force_merge!(key => value)
+                end
+                [task, value]
+            end
+
+            # Tasks are removed when they get finalized
+            def garbage_task(time, plan, task, can_finalize); end
+
+            # Events are removed when they get finalized
+            def garbage_event(time, plan, event); end
+
+            def finalized_task(time, plan_id, task)
+                plan = local_object(plan_id)
+                task = local_object(task)
+                if plan.has_task?(task)
+                    measure(:finalized_task) { plan.remove_task(task, time) }
+                end
+                object_manager.deregister_object(task)
+                [plan, task]
+            end
+
+            def finalized_event(time, plan_id, event)
+                plan  = local_object(plan_id)
+                event = local_object(event)
+                if event.root_object? && plan.has_free_event?(event)
+                    measure(:finalized_event) { plan.remove_free_event(event, time) }
+                end
+                object_manager.deregister_object(event)
+                [plan, event]
+            end
+
+            def task_failed_to_start(time, task, reason)
+                task   = local_object(task)
+                reason = local_object(reason)
+                measure(:task_failed_to_start) do
+                    task.mark_failed_to_start(reason, time)
+                end
+                [task, reason]
+            end
+
+            def generator_fired(time, event)
+                event     = local_object(event)
+                generator = event.generator
+                measure(:generator_fired) do
+                    generator.history << event
+                    generator.instance_eval { @emitted = true }
+                    generator.task.fired_event(event) if generator.respond_to?(:task)
+                end
+                event
+            end
+
+            def generator_emit_failed(time, *); end
+
+            def generator_propagate_events(time, *); end
+
+            def generator_unreachable(time, *); end
+
+            def exception_notification(time, *); end
+
+            def scheduler_report_pending_non_executable_task(time, *); end
+
+            def scheduler_report_trigger(time, *); end
+
+            def scheduler_report_holdoff(time, *); end
+
+            def scheduler_report_action(time, *); end
+
+            def cycle_end(time, timings)
+                @state = timings.delete(:state)
+                @stats = timings
+                @start_time ||= cycle_start_time
+            end
+
+            def clear_integrated
+                clear_changes
+            end
+        end
+    end
+end
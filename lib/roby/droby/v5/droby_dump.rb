@@ -172,7 +172,7 @@ def proxy(peer)
 
             module ExecutionExceptionDumper
                 def droby_dump(peer)
-                    DRoby.new(peer.dump(trace),
+                    DRoby.new(peer.dump(trace.to_graph),
                               peer.dump(exception),
                               handled)
                 end
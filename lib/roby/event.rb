@@ -11,7 +11,10 @@ class Event
 
         def initialize(generator, propagation_id, context, time = Time.now)
             @generator, @propagation_id, @context, @time = generator, propagation_id, context.freeze, time
-            @sources = Set.new
+            @provenance = nil
+            @provenance_index = nil
+            @protected_sources = nil
+            @protected_all_sources = nil
         end
 
         def plan
@@ -22,26 +25,26 @@ def plan
         protected :propagation_id=, :context=, :time=
 
         # The events whose emission directly triggered this event during the
-        # propagation. The events in this set are subject to Ruby's own
-        # garbage collection, which means that if a source event is garbage
-        # collected (i.e. if all references to the associated task/event
-        # generator are removed), it will be removed from this set as well.
+        # propagation
+        #
+        # The sources are stored in the {EventProvenance} arena of the cycle
+        # this event has been emitted in. They are forgotten once the engine
+        # releases that arena (see {ExecutionEngine#provenance_retention}),
+        # unless {#protect_sources} or {#protect_all_sources} has been called.
+        #
+        # @return [Set<Event>]
         def sources
-            result = Set.new
-            @sources.delete_if do |ref|
-                begin
-                    result << ref.__getobj__
-                    false
-                rescue WeakRef::RefError
-                    true
-                end
-            end
-            result
+            return @protected_sources.dup if @protected_sources
+            return Set.new unless @provenance
+
+            @provenance[@provenance_index].to_set
         end
 
         # Recursively computes the source event that led to the emission of
         # +self+
         def all_sources
+            return @protected_all_sources.dup if @protected_all_sources
+
             result = Set.new
             sources.each do |ev|
                 result << ev
@@ -50,31 +53,57 @@ def all_sources
             result
         end
 
-        # Call to protect this event's source from Ruby's garbage collection.
-        # Call this if you want to store the propagation history for this event
+        # Call to keep this event's sources regardless of the engine's
+        # provenance retention. Call this if you want to store the propagation
+        # history for this event
         def protect_sources
             @protected_sources = sources
         end
 
-        # Call to recursively protect this event's sources from Ruby's garbage
-        # collection. Call this if you want to store the propagation history for
-        # this event
+        # Call to recursively keep this event's sources regardless of the
+        # engine's provenance retention. Call this if you want to store the
+        # propagation history for this event
         def protect_all_sources
             @protected_all_sources = all_sources
+            protect_sources
         end
 
         # Sets the sources. See #sources
         def sources=(new_sources) # :nodoc:
-            @sources = Set.new
+            @provenance = nil
+            @provenance_index = nil
+            @protected_sources = nil
+            @protected_all_sources = nil
             add_sources(new_sources)
         end
 
+        # Register events that caused the emission of this event
+        #
+        # @param [#each] new_sources
         def add_sources(new_sources)
-            for new_s in new_sources
-                @sources << WeakRef.new(new_s)
+            return if new_sources.empty?
+
+            if @protected_sources
+                @protected_sources.merge(new_sources)
+            elsif @provenance
+                @provenance.append(@provenance_index, new_sources)
+            else
+                @provenance = provenance_arena
+                @provenance_index = @provenance.record(new_sources)
+                @provenance = nil unless @provenance_index
             end
         end
 
+        # @api private
+        #
+        # The arena in which this event's sources should be recorded
+        #
+        # @return [EventProvenance]
+        def provenance_arena
+            engine = generator.execution_engine if generator.respond_to?(:execution_engine)
+            engine&.provenance_arena || EventProvenance.new
+        end
+
         def root_sources
             all = all_sources
             all.find_all do |event|
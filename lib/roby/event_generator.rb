@@ -74,7 +74,7 @@ def initialize_copy(old) # :nodoc:
             super
 
             @event_model = old.event_model
-            @preconditions = old.instance_variable_get(:@preconditions).dup
+            @preconditions = old.instance_variable_get(:@preconditions)&.dup
             @handlers = old.handlers.dup
             @emitted = old.emitted?
             @history = old.history.dup
@@ -82,6 +82,7 @@ def initialize_copy(old) # :nodoc:
             if old.command.kind_of?(Method)
                 @command = method(old.command.name)
             end
+            @unreachable_events = nil
             @unreachable = old.unreachable?
             @unreachable_handlers = old.unreachable_handlers.dup
         end
@@ -116,12 +117,12 @@ def plan=(plan)
         # as soon as its command is called. If no argument is given (or a
         # +false+ argument), then it is not controlable
         def initialize(command_object = nil, controlable: false, plan: TemplatePlan.new, &command_block)
-            @preconditions   = []
+            @preconditions   = nil
             @handlers        = []
             @pending         = false
-            @pending_sources = []
+            @pending_sources = NO_PENDING_SOURCES
             @unreachable     = false
-            @unreachable_events = {}
+            @unreachable_events = nil
             @unreachable_handlers = []
             @history = []
             @event_model = Event
@@ -135,7 +136,7 @@ def initialize(command_object = nil, controlable: false, plan: TemplatePlan.new,
                     elsif command_block
                         command_block
                     else
-                        method(:default_command)
+                        DEFAULT_COMMAND
                     end
             else
                 @command = nil
@@ -149,8 +150,25 @@ def default_command(context) # :nodoc:
             emit(*context)
         end
 
+        # Placeholder for {#command} when the generator uses
+        # {#default_command}. The Method object is only created on first
+        # access, as most generators never have their command called.
+        DEFAULT_COMMAND = :default_command
+
+        # Value of the pending sources when there are none
+        NO_PENDING_SOURCES = [].freeze
+
         # The current command block
-        attr_accessor :command
+        attr_writer :command
+
+        # The current command block
+        def command
+            if @command == DEFAULT_COMMAND
+                @command = method(:default_command)
+            else
+                @command
+            end
+        end
 
         # True if this event is controlable
         def controlable?
@@ -469,6 +487,7 @@ def when_unreachable(cancel_at_emission = false, &block)
             # a GC point of view (being able to do this would be useful, but
             # anyway). So, it is possible that it is GCed because the event
             # user did not take care to use it.
+            @unreachable_events ||= {}
             if !@unreachable_events[cancel_at_emission] || !@unreachable_events[cancel_at_emission].plan
                 result = EventGenerator.new(true)
                 if_unreachable(cancel_at_emission: cancel_at_emission) do
@@ -658,7 +677,7 @@ def emit_failed(error = nil, message = nil)
 
             if Class === error
                 error = error.new(nil, self)
-                error.set_backtrace caller(1)
+                error.set_backtrace Roby.framework_backtrace
             end
 
             new_error = error.exception failure_message
@@ -694,8 +713,9 @@ def emit_without_propagation(context)
                 raise TypeError, "#{event} is not a valid event object in #{self}"
             end
 
-            event.add_sources(execution_engine.propagation_source_events)
-            event.add_sources(@pending_sources)
+            sources = execution_engine.propagation_source_events
+            sources.merge(@pending_sources) unless @pending_sources.empty?
+            event.add_sources(sources)
             fire(event)
             event
         ensure
@@ -852,12 +872,12 @@ def last
         # If the handler returns false, the calling is aborted by a
         # PreconditionFailed exception
         def precondition(reason = nil, &block)
-            @preconditions << [reason, block]
+            (@preconditions ||= []) << [reason, block]
         end
 
         # Yields all precondition handlers defined for this generator
         def each_precondition
-            @preconditions.each { |o| yield(o) }
+            @preconditions&.each { |o| yield(o) }
         end
 
         # Call this method in the #calling hook to cancel calling the event
@@ -869,12 +889,16 @@ def cancel(reason = nil)
 
         def pending(sources)
             @pending = true
-            @pending_sources.concat(sources)
+            if @pending_sources.frozen?
+                @pending_sources = sources.dup
+            else
+                @pending_sources.concat(sources)
+            end
         end
 
         def clear_pending
             @pending = false
-            @pending_sources = []
+            @pending_sources = NO_PENDING_SOURCES
         end
 
         # Hook called when this event generator is called (i.e. the associated
@@ -0,0 +1,66 @@
+# frozen_string_literal: true
+
+module Roby
+    # Storage for the sources of the events emitted during one execution
+    # cycle
+    #
+    # An {Event} refers to its sources through an index in the arena of the
+    # cycle it has been emitted in. {ExecutionEngine} releases arenas that
+    # are older than {ExecutionEngine#provenance_retention} cycles, after which
+    # the events that have been recorded in them report no sources. Use
+    # {Event#protect_sources} or {Event#protect_all_sources} to keep the
+    # sources of a given event beyond that.
+    #
+    # This replaces per-source WeakRef objects, which are expensive to create
+    # and dereference, by a plain array per event that gets dropped in bulk.
+    class EventProvenance
+        EMPTY = [].freeze
+
+        def initialize
+            @records = []
+        end
+
+        # Whether this arena has been released
+        def released?
+            !@records
+        end
+
+        # Number of events recorded in this arena
+        def size
+            @records&.size || 0
+        end
+
+        # Record the sources of a new event
+        #
+        # @param [#to_a] sources
+        # @return [Integer,nil] the record index, to be used in {#[]} and
+        #   {#append}. It is nil if the arena is released
+        def record(sources)
+            return unless @records
+
+            @records << (sources.kind_of?(Array) ? sources.dup : sources.to_a)
+            @records.size - 1
+        end
+
+        # Add sources to an existing record
+        def append(index, sources)
+            return unless @records
+
+            @records[index].concat(sources.to_a)
+        end
+
+        # The sources of a given record
+        #
+        # @return [Array<Event>]
+        def [](index)
+            return EMPTY unless @records
+
+            @records[index]
+        end
+
+        # Release the recorded sources
+        def release
+            @records = nil
+        end
+    end
+end
@@ -389,6 +389,19 @@ def schedule_as(task)
                  dag: false
 
         class TemporalConstraints
+            # Number of events of a generator history that have been emitted at
+            # or before the given time
+            #
+            # The history is sorted by emission time, so this is a binary
+            # search instead of a scan of the whole history
+            #
+            # @param [Array<Event>] history
+            # @param [Time] time
+            # @return [Integer]
+            def self.count_emissions_until(history, time)
+                history.bsearch_index { |ev| ev.time > time } || history.size
+            end
+
             module EventFiredHook
                 # Overloaded to register deadlines that this event's emissions
                 # define
@@ -475,14 +488,27 @@ def find_failed_temporal_constraint(time)
                             next
                         end
 
-                        max_diff = disjoint_set.boundaries[1]
-                        parent.history.each do |parent_event|
-                            diff = time - parent_event.time
-                            if diff > max_diff || !disjoint_set.include?(diff)
+                        history = parent.history
+                        next if history.empty?
+
+                        min_diff, max_diff = disjoint_set.boundaries
+                        # The oldest emission has the biggest time difference
+                        if time - history.first.time > max_diff
+                            return parent, disjoint_set
+                        end
+
+                        if disjoint_set.intervals.size == 1
+                            # The time differences of all the other emissions
+                            # are between the ones of the oldest and the newest
+                            if time - history.last.time < min_diff
                                 return parent, disjoint_set
                             end
-
-                            disjoint_set.include?(diff)
+                        else
+                            history.each do |parent_event|
+                                unless disjoint_set.include?(time - parent_event.time)
+                                    return parent, disjoint_set
+                                end
+                            end
                         end
                     end
                     nil
@@ -546,15 +572,14 @@ def find_failed_occurence_constraint(next_event)
 
                         constraints = parent[self, TemporalConstraints]
                         counts = { false => parent.history.size }
-                        if base_time
-                            negative_count = parent.history.inject(0) do |count, ev|
-                                break(count) if ev.time > base_time
-
-                                count + 1
+                        negative_count =
+                            if base_time
+                                TemporalConstraints.count_emissions_until(
+                                    parent.history, base_time
+                                )
+                            else
+                                0
                             end
-                        else
-                            negative_count = 0
-                        end
                         counts[true] = counts[false] - negative_count
                         counts.each do |recurrent, count|
                             min_count, max_count = constraints.occurence_constraints[recurrent]
@@ -0,0 +1,90 @@
+# frozen_string_literal: true
+
+module Roby
+    # Cache of the exception handlers that may match a given exception
+    #
+    # Exception handlers are looked for by testing each registered matcher
+    # against the propagated exception with #===. This index buckets the
+    # handlers by the class of the underlying error and the model of the task
+    # it originates from, so that only the handlers that can possibly match are
+    # tested. The order of the handlers within a bucket is the order of the
+    # original list, so handler priorities (and {Task#pass_exception}) are
+    # not affected.
+    #
+    # Matchers that do not provide {Queries::ExecutionExceptionMatcher#may_match?}
+    # are always considered as candidates.
+    #
+    # The cached buckets are invalidated whenever a handler is registered
+    # anywhere (see {.invalidate}). This is a global operation because handler
+    # lists are inherited along model hierarchies.
+    class ExceptionHandlerIndex
+        @generation = 0
+
+        class << self
+            # A counter that is incremented each time a handler list is
+            # modified
+            attr_reader :generation
+
+            # Invalidate all existing indexes
+            #
+            # It must be called whenever a handler is added to a list that is
+            # indexed
+            def invalidate
+                @generation += 1
+            end
+
+            # @api private
+            #
+            # The key under which exceptions are bucketed
+            #
+            # @param [ExecutionException] execution_exception
+            # @return [(Class,Models::Task)]
+            def dispatch_key(execution_exception)
+                error = execution_exception.exception
+                origin = error.failed_task if error.respond_to?(:failed_task)
+                [error.class, origin&.model]
+            end
+
+            # Whether the given matcher may match exceptions with the given
+            # dispatch key
+            #
+            # @param [#===] matcher
+            # @param [(Class,Models::Task)] key as returned by {.dispatch_key}
+            def candidate?(matcher, key)
+                return true unless matcher.respond_to?(:may_match?)
+
+                matcher.may_match?(*key)
+            end
+        end
+
+        def initialize
+            @generation = nil
+            @buckets = {}
+        end
+
+        # Enumerate the handlers that may match the given exception
+        #
+        # @param [ExecutionException] execution_exception
+        # @param [#each] handlers the full ordered handler list
+        # @yieldparam handler an element of the handlers list
+        # @yieldreturn [#===] the matcher for this handler
+        # @return [Array] the subset of handlers that are candidates for this
+        #   exception, in the order of the handlers list
+        def candidates(execution_exception, handlers)
+            if @generation != ExceptionHandlerIndex.generation
+                @buckets.clear
+                @generation = ExceptionHandlerIndex.generation
+            end
+
+            key = ExceptionHandlerIndex.dispatch_key(execution_exception)
+            @buckets[key] ||= handlers.find_all do |h|
+                ExceptionHandlerIndex.candidate?(yield(h), key)
+            end
+        end
+
+        # Removes all cached buckets
+        def clear
+            @buckets.clear
+        end
+    end
+end
@@ -0,0 +1,219 @@
+# frozen_string_literal: true
+
+module Roby
+    # The propagation trace of an {ExecutionException}
+    #
+    # Exception propagation forks an exception each time a task has more than
+    # one parent and merges the siblings back when they reach a common parent.
+    # Instead of copying and merging full graphs, the trace is stored as a set
+    # of immutable links that point to the links they have been propagated
+    # from. Forking therefore shares the whole propagation prefix, and merging
+    # only concatenates the two sets of heads.
+    #
+    # The graph-like view ({#each_vertex}, {#each_edge}, {#leaf?}, ...) is
+    # computed on demand and cached until the trace is modified.
+    class ExceptionTrace
+        include Enumerable
+
+        # One propagation step
+        #
+        # @!method parents
+        #   @return [Array<Link>] the links this step has been propagated
+        #     from
+        # @!method from
+        #   @return [Task]
+        # @!method to
+        #   @return [Task]
+        Link = Struct.new :parents, :from, :to
+
+        NO_LINKS = [].freeze
+
+        # @api private
+        #
+        # The cached graph-like view
+        Structure = Struct.new :vertices, :vertex_set, :edges, :non_leafs
+
+        # The vertices that are part of the trace even if no edge refers to
+        # them (i.e. the exception origin)
+        #
+        # @return [Array<Task>]
+        attr_reader :roots
+
+        # The most recent propagation steps
+        #
+        # @return [Array<Link>]
+        attr_reader :heads
+
+        def initialize(roots = NO_LINKS)
+            @roots = roots.dup.freeze
+            @heads = NO_LINKS
+            @structure = nil
+        end
+
+        # Register a vertex that may not be part of any edge
+        def add_vertex(vertex)
+            return if @roots.include?(vertex)
+
+            @roots = (@roots + [vertex]).freeze
+            @structure = nil
+        end
+
+        # Add a propagation step
+        #
+        # The new step is a successor of all the current heads
+        def add_edge(from, to, _info = nil)
+            @heads = [Link.new(@heads, from, to)].freeze
+            @structure = nil
+        end
+
+        # Merge another trace into this one
+        #
+        # This is O(number of heads), the two traces share their links
+        #
+        # @param [ExceptionTrace] trace
+        # @return [self]
+        def merge(trace)
+            heads = trace.heads.reject { |l| @heads.any? { |h| h.equal?(l) } }
+            roots = trace.roots.reject { |v| @roots.include?(v) }
+            return self if heads.empty? && roots.empty?
+
+            @heads = (@heads + heads).freeze
+            @roots = (@roots + roots).freeze
+            @structure = nil
+            self
+        end
+
+        # Replace the content of this trace by the one of another trace or
+        # graph
+        #
+        # @param [ExceptionTrace,#each_vertex,#each_edge] trace
+        def replace(trace)
+            if trace.kind_of?(ExceptionTrace)
+                @roots = trace.roots
+                @heads = trace.heads
+            else
+                @roots = trace.each_vertex.to_a.freeze
+                @heads = trace.each_edge.map { |u, v, _| Link.new(NO_LINKS, u, v) }
+                              .freeze
+            end
+            @structure = nil
+            self
+        end
+
+        # Enumerate the tasks involved in this trace
+        def each_vertex(&block)
+            return enum_for(__method__) unless block_given?
+
+            structure.vertices.each(&block)
+        end
+
+        alias each each_vertex
+
+        # The tasks involved in this trace
+        #
+        # @return [Array<Task>]
+        def vertices
+            structure.vertices
+        end
+
+        # Enumerate the propagation steps as (from, to, nil) triplets
+        #
+        # Each edge is yielded only once
+        def each_edge
+            return enum_for(__method__) unless block_given?
+
+            structure.edges.each { |from, to| yield(from, to, nil) }
+        end
+
+        def has_vertex?(vertex)
+            structure.vertex_set.include?(vertex)
+        end
+
+        # Whether the given vertex has not been propagated further
+        def leaf?(vertex)
+            !structure.non_leafs.include?(vertex)
+        end
+
+        # The vertices that have not been propagated further
+        #
+        # @return [Array<Task>]
+        def leafs
+            structure.vertices.find_all { |v| leaf?(v) }
+        end
+
+        def empty?
+            @roots.empty? && @heads.empty?
+        end
+
+        # Convert this trace into a plain graph
+        #
+        # @return [Relations::BidirectionalDirectedAdjacencyGraph]
+        def to_graph
+            graph = Relations::BidirectionalDirectedAdjacencyGraph.new
+            each_vertex { |v| graph.add_vertex(v) }
+            each_edge { |u, v, _| graph.add_edge(u, v, nil) }
+            graph
+        end
+
+        # @api private
+        #
+        # Compute (or return the cached) graph-like view of the trace
+        def structure
+            @structure ||= compute_structure
+        end
+
+        # @api private
+        #
+        # Enumerate the links reachable from the heads, parents first
+        def each_link
+            return enum_for(__method__) unless block_given?
+
+            state = {}.compare_by_identity
+            stack = @heads.reverse
+            until stack.empty?
+                link = stack.last
+                case state[link]
+                when :done
+                    stack.pop
+                when :open
+                    stack.pop
+                    state[link] = :done
+                    yield(link)
+                else
+                    state[link] = :open
+                    link.parents.reverse_each do |p|
+                        stack << p unless state[p]
+                    end
+                end
+            end
+        end
+
+        # @api private
+        def compute_structure
+            vertex_set = Set.new
+            vertices = []
+            @roots.each { |v| vertices << v if vertex_set.add?(v) }
+
+            edges = []
+            edge_set = Set.new
+            non_leafs = Set.new
+            each_link do |link|
+                from, to = link.from, link.to
+                next unless edge_set.add?([from, to])
+
+                edges << [from, to]
+                non_leafs << from
+                vertices << from if vertex_set.add?(from)
+                vertices << to if vertex_set.add?(to)
+            end
+            Structure.new(vertices.freeze, vertex_set.freeze,
+                          edges.freeze, non_leafs.freeze)
+        end
+
+        def pretty_print(pp)
+            pp.seplist(structure.edges) do |from, to|
+                pp.text "#{from} => #{to}"
+            end
+        end
+    end
+end
@@ -30,6 +30,28 @@ def self.enable_colors
         @colorizer = Pastel.new(enabled: true)
     end
 
+    class << self
+        # Maximum number of backtrace lines captured by the framework when it
+        # generates errors itself (e.g. {EventGenerator#emit_failed})
+        #
+        # This does not apply to exceptions raised by user code. Set to nil
+        # (the default) to capture the full backtrace
+        #
+        # @return [Integer,nil]
+        attr_accessor :framework_backtrace_depth
+    end
+    @framework_backtrace_depth = nil
+
+    # Returns the backtrace to assign to an error generated by the framework
+    #
+    # @param [Integer] skip the number of stack frames to skip, not counting
+    #   this method's own
+    # @return [Array<String>]
+    # @see framework_backtrace_depth
+    def self.framework_backtrace(skip = 1)
+        caller(skip + 1, framework_backtrace_depth)
+    end
+
     # ExecutionException objects are used during the exception handling stage
     # to keep information about the propagation.
     #
@@ -41,13 +63,13 @@ def self.enable_colors
     class ExecutionException
         # The trace of how this exception has been propagated in the plan so far
         #
-        # @return [Relations::BidirectionalDirectedAdjacencyGraph]
+        # @return [ExceptionTrace]
         attr_reader :trace
 
         # The last object(s) that handled the exception. This is either a
         # single object or an array
         def propagation_leafs
-            trace.each_vertex.find_all { |v| trace.leaf?(v) }
+            trace.leafs
         end
 
         # The object from which the exception originates
@@ -85,8 +107,7 @@ def involved_task?(task)
 
         # Resets the trace to [origin]
         def reset_trace
-            @trace = Relations::BidirectionalDirectedAdjacencyGraph.new
-            @trace.add_vertex(@origin)
+            @trace = ExceptionTrace.new([@origin])
         end
 
         # True if this exception originates from the given task or generator
@@ -100,7 +121,7 @@ def originates_from?(object)
         # call #generator.task
         def initialize(exception)
             @exception = exception
-            @trace = Relations::BidirectionalDirectedAdjacencyGraph.new
+            @trace = ExceptionTrace.new
 
             if task = exception.failed_task
                 @origin = task
@@ -116,6 +137,8 @@ def initialize(exception)
         end
 
         # Create a sibling from this exception
+        #
+        # The sibling shares the trace so far with this exception
         def fork
             dup
         end
@@ -171,6 +194,10 @@ def pretty_print(pp)
     # able to handle exception. These objects should define
     #   #each_exception_handler { |matchers, handler| ... }
     #
+    # They may also define #each_candidate_exception_handler to restrict the
+    # handlers that are tested against a given exception (see
+    # {ExceptionHandlerIndex})
+    #
     # See Task::on_exception and Task#on_exception
     module ExceptionHandlingObject
         module ClassExtension
@@ -188,10 +215,19 @@ def add_error(error, propagate_through: nil)
             execution_engine.add_error(error, propagate_through: propagate_through)
         end
 
+        # Enumerates the exception handlers that may match the given exception
+        #
+        # The default is to enumerate all of them. Objects that maintain an
+        # {ExceptionHandlerIndex} overload it to enumerate only the relevant
+        # subset, in the same order than {#each_exception_handler}
+        def each_candidate_exception_handler(_exception_object, &block)
+            each_exception_handler(&block)
+        end
+
         # Calls the exception handlers defined in this task for +exception_object.exception+
         # Returns true if the exception has been handled, false otherwise
         def handle_exception(exception_object)
-            each_exception_handler do |matcher, handler|
+            each_candidate_exception_handler(exception_object) do |matcher, handler|
                 if exception_object.exception.kind_of?(FailedExceptionHandler)
                     # Do not handle a failed exception handler by itself
                     next if exception_object.exception.handler == handler
@@ -232,6 +268,7 @@ def self.filter_backtrace(original_backtrace = nil, force: false, display_full_f
 
         if (Roby.app.filter_backtraces? || force) && original_backtrace
             app_dir = Roby.app.app_dir
+            framework_line = backtrace_line_classifier(filter_out)
 
             original_backtrace = original_backtrace.dup
 
@@ -239,7 +276,7 @@ def self.filter_backtrace(original_backtrace = nil, force: false, display_full_f
             # first backtrace line that is within the framework
             backtrace_bottom = []
             while !original_backtrace.empty? &&
-                  filter_out.none? { |rx| rx.match?(original_backtrace.last) }
+                  !framework_line[original_backtrace.last]
                 backtrace_bottom.unshift original_backtrace.pop
             end
 
@@ -265,7 +302,7 @@ def self.filter_backtrace(original_backtrace = nil, force: false, display_full_f
                         got_user_line = true
                         line.gsub(/:in /, ":in event handler, ")
                     else
-                        is_user = filter_out.none? { |rx| rx.match?(line) }
+                        is_user = !framework_line[line]
                         got_user_line ||= is_user
                         if !got_user_line || is_user
                             case line
@@ -295,6 +332,36 @@ def self.filter_backtrace(original_backtrace = nil, force: false, display_full_f
         backtrace || original_backtrace || []
     end
 
+    # Maximum number of backtrace lines whose classification is cached by
+    # {.backtrace_line_classifier}
+    BACKTRACE_LINE_CACHE_SIZE = 10_000
+
+    # @api private
+    #
+    # Returns a hash that tells whether a given backtrace line matches one of
+    # the filter-out patterns
+    #
+    # Backtraces of errors generated within the same cycle share most of their
+    # lines. The classification is therefore cached, and the cache is reset
+    # when the patterns change or when it grows too big
+    #
+    # The cache is per-thread, as backtraces are also filtered in
+    # {ExecutionEngine#exception_display_executor}
+    #
+    # @param [Array<Regexp>] filter_out
+    # @return [Hash<String,Boolean>]
+    def self.backtrace_line_classifier(filter_out)
+        patterns, cache = Thread.current[:roby_backtrace_line_classifier]
+        if !cache || patterns != filter_out ||
+           cache.size > BACKTRACE_LINE_CACHE_SIZE
+            cache = Hash.new do |h, line|
+                h[line] = filter_out.any? { |rx| rx.match?(line) }
+            end
+            Thread.current[:roby_backtrace_line_classifier] = [filter_out.dup, cache]
+        end
+        cache
+    end
+
     def self.pretty_print_backtrace(pp, backtrace, **options)
         if backtrace && !backtrace.empty?
             pp.nest(2) do
@@ -432,6 +499,73 @@ def self.log_error(e, logger, level, with_backtrace: true)
         end
     end
 
+    # Plain copy of the data of an exception
+    #
+    # It is created in the engine thread by
+    # {ExecutionEngine#display_exceptions=} when there is an
+    # {ExecutionEngine#exception_display_executor}, so that the exception can be
+    # filtered and pretty-printed in the executor while the engine modifies the
+    # plan objects the original exception refers to. It is accepted by
+    # {Roby.log_exception_with_backtrace}.
+    #
+    # Only strings are kept: the class name, the message, the failure point
+    # as returned by its #to_s and the raw backtrace. The report is therefore
+    # less detailed than the exception's own #pretty_print.
+    class ExceptionSnapshot
+        # @return [String] the name of the exception class
+        attr_reader :class_name
+        # @return [String] the exception message
+        attr_reader :message
+        # @return [String,nil] the failure point of a {LocalizedError}
+        attr_reader :failure_point
+        # @return [Array<String>] the unfiltered backtrace
+        attr_reader :backtrace
+        # @return [Array<ExceptionSnapshot>] snapshots of the exception's
+        #   original exceptions
+        attr_reader :original_exceptions
+
+        def initialize(class_name, message, failure_point, backtrace,
+                       original_exceptions)
+            @class_name = class_name
+            @message = message
+            @failure_point = failure_point
+            @backtrace = backtrace
+            @original_exceptions = original_exceptions
+            freeze
+        end
+
+        # Creates a snapshot of an exception and of its original exceptions
+        #
+        # @param [Exception] exception
+        # @return [ExceptionSnapshot]
+        def self.capture(exception)
+            failure_point =
+                if exception.respond_to?(:failure_point)
+                    exception.failure_point.to_s.dup.freeze
+                end
+            original_exceptions =
+                if exception.respond_to?(:original_exceptions)
+                    exception.original_exceptions.map { |e| capture(e) }
+                else []
+                end
+
+            new(exception.class.to_s.dup.freeze,
+                exception.message.dup.freeze,
+                failure_point,
+                (exception.backtrace || []).map { |l| l.dup.freeze }.freeze,
+                original_exceptions.freeze)
+        end
+
+        def pretty_print(pp)
+            pp.text class_name
+            pp.text ": #{message}" unless message.empty? || message == class_name
+            return unless failure_point
+
+            pp.breakable
+            pp.text "at #{failure_point}"
+        end
+    end
+
     class BacktraceFormatter
         attr_reader :backtrace
         def initialize(exception, backtrace = exception.backtrace)
@@ -50,6 +50,7 @@ def initialize(event_logger: DRoby::NullEventLogger.new)
             @execution_engine = ExecutionEngine.new(self)
             @force_gc = Set.new
             @exception_handlers = []
+            @exception_handler_index = ExceptionHandlerIndex.new
             on_exception LocalizedError do |plan, error|
                 plan.default_localized_error_handling(error)
             end
@@ -229,7 +230,7 @@ def added_edge(parent, child, relations, info)
                 end
             end
 
-            log(:added_edge, parent, child, relations, info)
+            log_edge_change(:added_edge, parent, child, relations, info)
         end
 
         # @api private
@@ -256,7 +257,7 @@ def updating_edge_info(parent, child, relation, info)
         # @param [Object] info the new edge info
         def updated_edge_info(parent, child, relation, info)
             emit_relation_change_hook(parent, child, relation, info, prefix: "updated")
-            log(:updated_edge_info, parent, child, relation, info)
+            log_edge_change(:updated_edge_info, parent, child, relation, info)
         end
 
         # @api private
@@ -306,7 +307,36 @@ def removed_edge(parent, child, relations)
                 end
             end
 
-            log(:removed_edge, parent, child, relations)
+            log_edge_change(:removed_edge, parent, child, relations)
+        end
+
+        # Groups the relation changes done within the block
+        #
+        # The changes are logged as a single :grouped_edge_changes message
+        # instead of one message per edge. Nested calls are part of the
+        # outermost group.
+        def group_edge_changes
+            return yield if @grouped_edge_changes
+
+            begin
+                changes = @grouped_edge_changes = []
+                yield
+            ensure
+                @grouped_edge_changes = nil
+                log(:grouped_edge_changes, changes) unless changes.empty?
+            end
+        end
+
+        # @api private
+        #
+        # Logs an edge change, or adds it to the current group if within
+        # {#group_edge_changes}
+        def log_edge_change(m, *args)
+            if @grouped_edge_changes
+                @grouped_edge_changes << [m, *args]
+            else
+                log(m, *args)
+            end
         end
 
         # @api private
@@ -470,6 +500,23 @@ def garbage_task(task)
             end
         end
 
+        # Called to garbage-collect a set of tasks that can all be finalized
+        #
+        # It is equivalent to calling {#garbage_task} on each of them, but
+        # removes the whole set with {#remove_tasks}. It is used by
+        # {ExecutionEngine#garbage_collect} to remove a subtree of tasks in a
+        # single operation.
+        #
+        # @param [Array<Task>] tasks tasks for which {Task#can_finalize?}
+        #   returns true
+        # @return [void]
+        def garbage_tasks(tasks)
+            tasks.each do |t|
+                log(:garbage_task, droby_id, t, true)
+            end
+            remove_tasks(tasks)
+        end
+
         # Called to handle a free event that should be garbage-collected
         #
         # What actually happens to the event is controlled by
@@ -503,6 +550,16 @@ def each_exception_handler(&block)
             exception_handlers.each(&block)
         end
 
+        # Iterate over the plan-wide exception handlers that may match the
+        # given exception
+        #
+        # @see ExceptionHandlerIndex
+        def each_candidate_exception_handler(exception_object, &block)
+            @exception_handler_index
+                .candidates(exception_object, exception_handlers) { |m, _| m }
+                .each(&block)
+        end
+
         # Register a new exception handler
         #
         # @param [#===,#to_execution_exception_matcher] matcher
@@ -517,6 +574,7 @@ def each_exception_handler(&block)
         def on_exception(matcher, &handler)
             check_arity(handler, 2)
             exception_handlers.unshift [matcher.to_execution_exception_matcher, handler]
+            @exception_handler_index.clear
         end
 
         # Actually remove a task from the plan
@@ -529,6 +587,16 @@ def remove_task(object, timestamp = nil)
             @force_gc.delete(object)
         end
 
+        # Actually remove a set of tasks from the plan
+        def remove_tasks(tasks, timestamp = Time.now)
+            running = tasks.find { |t| t.running? && t.self_owned? }
+            if running
+                raise ArgumentError, "attempting to remove #{running}, which is a running task, from an executable plan"
+            end
+
+            super
+        end
+
         # Clear the plan
         def clear
             super
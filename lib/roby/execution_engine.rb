@@ -102,6 +102,8 @@ def initialize(plan, control: Roby::DecisionControl.new, event_logger: plan.even
             @side_work_handlers = []
             @at_cycle_end_handlers = []
             @process_every = []
+            @delayed_blocks = []
+            @poll_scheduler = PollScheduler.new(self)
             @waiting_work = Concurrent::Array.new
             @emitted_events = []
             @exception_listeners = []
@@ -113,6 +115,7 @@ def initialize(plan, control: Roby::DecisionControl.new, event_logger: plan.even
             @pending_exceptions = {}
 
             each_cycle(&ExecutionEngine.method(:call_every))
+            each_cycle(&ExecutionEngine.method(:call_delayed))
 
             @quit = 0
             @allow_propagation = true
@@ -122,6 +125,9 @@ def initialize(plan, control: Roby::DecisionControl.new, event_logger: plan.even
             @last_stop_count = 0
             @finalizers = []
             @gc_warning = true
+            @provenance_retention = DEFAULT_PROVENANCE_RETENTION
+            @provenance_arenas = []
+            advance_provenance_arena
 
             refresh_relations
 
@@ -171,6 +177,74 @@ def refresh_relations
         # graph over and over
         attr_reader :dependency_graph
 
+        # Default value for {#provenance_retention}
+        #
+        # Sources are kept as long as the events themselves, as error messages
+        # and unreachability explanations refer to them
+        DEFAULT_PROVENANCE_RETENTION = nil
+
+        # How many cycles the sources of the emitted events are kept
+        #
+        # The sources of the events emitted in a cycle (see {Event#sources})
+        # are forgotten once that many cycles have been started since. 1
+        # means that they are only available within the cycle the event has
+        # been emitted in. If nil (the default), they are kept as long as the
+        # events themselves.
+        #
+        # Sources protected with {Event#protect_sources} or
+        # {Event#protect_all_sources} are not affected. Note that some
+        # diagnostics, such as the messages of {EmissionRejected} or the
+        # explanations of why an event became unreachable, report the sources
+        # of events that may have been emitted long before. They do not name
+        # these sources anymore once they got forgotten.
+        #
+        # @return [Integer,nil]
+        attr_reader :provenance_retention
+
+        # Sets {#provenance_retention}
+        def provenance_retention=(cycles)
+            if cycles && cycles < 1
+                raise ArgumentError,
+                      "the provenance retention must be at least one cycle, "\
+                      "got #{cycles}"
+            end
+
+            @provenance_retention = cycles
+            release_provenance_arenas
+        end
+
+        # The arena in which the sources of the events emitted in the current
+        # cycle are stored
+        #
+        # @return [EventProvenance]
+        attr_reader :provenance_arena
+
+        # @api private
+        #
+        # Start a new provenance arena for a new cycle, and release the ones
+        # that are older than {#provenance_retention}
+        def advance_provenance_arena
+            @provenance_arena = EventProvenance.new
+            @provenance_arenas << @provenance_arena
+            release_provenance_arenas
+        end
+
+        # @api private
+        #
+        # Release the provenance arenas that are older than
+        # {#provenance_retention}
+        def release_provenance_arenas
+            unless provenance_retention
+                # Arenas are kept alive by their events
+                @provenance_arenas = [@provenance_arena].compact
+                return
+            end
+
+            while @provenance_arenas.size > provenance_retention
+                @provenance_arenas.shift.release
+            end
+        end
+
         # The Plan this engine is acting on
         attr_accessor :plan
         # The underlying {DRoby::EventLogger}
@@ -820,6 +894,9 @@ def gather_external_events
             gather_framework_errors("delayed events") { execute_delayed_events }
             call_poll_blocks(self.class.external_events_handlers)
             call_poll_blocks(self.external_events_handlers)
+            log_timepoint_group "task polls" do
+                poll_scheduler.call
+            end
         end
 
         def call_propagation_handlers
@@ -1428,14 +1505,31 @@ def once(sync: nil, description: "once block", type: :external_events, **options
 
         # Schedules +block+ to be called once after +delay+ seconds passed, in
         # the propagation context
+        #
+        # Pending blocks are kept sorted by deadline in {#delayed_blocks}, so
+        # that they cost nothing until their deadline is reached
+        #
+        # @return [#dispose] an object whose dispose method cancels the call
         def delayed(delay, description: "delayed block", **options, &block)
             handler = PollBlockDefinition.new(description, block, once: true, **options)
             once do
-                process_every << [handler, cycle_start, delay]
+                deadline = cycle_start + delay
+                index = delayed_blocks.bsearch_index { |t, _| t > deadline }
+                delayed_blocks.insert(index || delayed_blocks.size, [deadline, handler])
             end
             handler
         end
 
+        # The scheduler for the poll blocks of the running tasks
+        #
+        # @return [PollScheduler]
+        attr_reader :poll_scheduler
+
+        # The blocks registered with {#delayed}, sorted by deadline
+        #
+        # @return [Array<(Time,PollBlockDefinition)>]
+        attr_reader :delayed_blocks
+
         # The set of errors which have been generated outside of the plan's
         # control. For now, those errors cause the whole controller to shut
         # down.
@@ -1513,7 +1607,7 @@ def process_waiting_work
                 work.rejected? && (work.respond_to?(:has_error_handler?) && !work.has_error_handler?)
             end.each do |work|
                 e = work.reason
-                e.set_backtrace(e.backtrace + caller)
+                e.set_backtrace(e.backtrace + Roby.framework_backtrace)
                 add_framework_error(e, work.to_s)
             end
 
@@ -1723,6 +1817,7 @@ def process_events(
             passed_recursive_check = true
             @application_exceptions = []
             @emitted_events = []
+            advance_provenance_arena
 
             @thread_pool.send :synchronize do
                 @thread_pool.send(:ns_prune_pool)
@@ -1953,6 +2048,8 @@ def garbage_collect(force_on = nil)
 
             unmark_finished_missions_and_permanent_tasks
 
+            gc_start = Time.now
+
             # The set of tasks for which we queued stop! at this cycle
             # #finishing? is false until the next event propagation cycle
             finishing = Set.new
@@ -1980,27 +2077,34 @@ def garbage_collect(force_on = nil)
                     break
                 end
 
-                # Mark all root local_tasks as garbage.
-                roots = local_tasks.dup
-                plan.each_task_relation_graph do |g|
-                    next if !g.root_relation? || g.weak?
+                # Handle the root local_tasks. The tasks are visited parents
+                # first, so that a whole subtree of tasks that can be removed
+                # is gathered in a single pass: a child becomes a root once
+                # all its parents are removed. The gathered tasks are then
+                # removed in one batch
+                root_graphs = plan.each_task_relation_graph.find_all do |g|
+                    g.root_relation? && !g.weak?
+                end
+                removed = Set.new
+                garbage_collection_order(local_tasks, root_graphs).each do |local_task|
+                    next if finishing.include?(local_task)
+                    next if local_task.plan != plan
 
-                    roots.delete_if do |t|
-                        g.each_in_neighbour(t).any? { |p| !p.finished? }
+                    is_root = root_graphs.none? do |g|
+                        g.each_in_neighbour(local_task).any? do |p|
+                            !p.finished? && !removed.include?(p)
+                        end
                     end
-                    break if roots.empty?
-                end
+                    next unless is_root
 
-                (roots.to_set - finishing).each do |local_task|
                     if local_task.pending?
                         info "GC: removing pending task #{local_task}"
-
-                        if plan.garbage_task(local_task)
+                        if garbage_task_in_batch(local_task, removed)
                             did_something = true
                         end
                     elsif local_task.failed_to_start?
                         info "GC: removing task that failed to start #{local_task}"
-                        if plan.garbage_task(local_task)
+                        if garbage_task_in_batch(local_task, removed)
                             did_something = true
                         end
                     elsif local_task.starting?
@@ -2008,7 +2112,7 @@ def garbage_collect(force_on = nil)
                         debug { "GC: #{local_task} is starting" }
                     elsif local_task.finished?
                         debug { "GC: #{local_task} is not running, removed" }
-                        if plan.garbage_task(local_task)
+                        if garbage_task_in_batch(local_task, removed)
                             did_something = true
                         end
                     elsif !local_task.finishing?
@@ -2038,6 +2142,7 @@ def garbage_collect(force_on = nil)
                         warn "GC: ignored #{local_task}"
                     end
                 end
+                plan.garbage_tasks(removed) unless removed.empty?
             end
 
             finishing.each(&:stop!)
@@ -2046,9 +2151,69 @@ def garbage_collect(force_on = nil)
                 plan.garbage_event(event)
             end
 
+            if @teardown_statistics
+                @teardown_statistics.gc_time += Time.now - gc_start
+                @teardown_statistics.stop_requests += finishing.size
+            end
             !finishing.empty?
         end
 
+        # @api private
+        #
+        # Adds a task to the batch of tasks removed by the current
+        # {#garbage_collect} pass if it can be finalized, and lets the plan
+        # handle it right away otherwise
+        #
+        # @param [Task] task
+        # @param [Set<Task>] batch
+        # @return [Boolean] true if the plan is (or will be) modified
+        def garbage_task_in_batch(task, batch)
+            if task.can_finalize?
+                batch << task
+                true
+            else
+                plan.garbage_task(task)
+            end
+        end
+
+        # @api private
+        #
+        # Sorts tasks so that parents are visited before their children in
+        # the given relation graphs
+        #
+        # Only the relations between the tasks of the set are considered.
+        # Tasks that are part of a cycle are placed at the end of the list
+        #
+        # @param [Set<Task>] tasks
+        # @param [Array<Relations::BidirectionalDirectedAdjacencyGraph>] graphs
+        # @return [Array<Task>]
+        def garbage_collection_order(tasks, graphs)
+            parent_count = Hash.new(0)
+            tasks.each do |t|
+                graphs.each do |g|
+                    g.each_out_neighbour(t) do |child|
+                        parent_count[child] += 1 if tasks.include?(child)
+                    end
+                end
+            end
+
+            order = tasks.find_all { |t| parent_count[t] == 0 }
+            order.each do |t|
+                graphs.each do |g|
+                    g.each_out_neighbour(t) do |child|
+                        next unless tasks.include?(child)
+
+                        order << child if (parent_count[child] -= 1) == 0
+                    end
+                end
+            end
+
+            if order.size != tasks.size
+                order.concat(tasks.find_all { |t| parent_count[t] > 0 })
+            end
+            order
+        end
+
         # Do not sleep or call Thread#pass if there is less that
         # this much time left in the cycle
         SLEEP_MIN_TIME = 0.01
@@ -2087,6 +2252,20 @@ def self.call_every(plan) # :nodoc:
             end.compact!
         end
 
+        # Calls the blocks registered with {#delayed} whose deadline has been
+        # reached
+        def self.call_delayed(plan) # :nodoc:
+            engine = plan.execution_engine
+            # Same rounding than {.call_every}: call the block if its deadline
+            # is closer to the beginning of this cycle than to the next
+            limit = engine.cycle_start + engine.cycle_length / 2
+            blocks = engine.delayed_blocks
+            until blocks.empty? || blocks.first[0] >= limit
+                _, handler = blocks.shift
+                handler.call(engine, engine.plan) unless handler.disposed?
+            end
+        end
+
         # A list of threaded objects waiting for the control thread
         #
         # Objects registered here will be notified them by calling {#fail} when
@@ -2235,26 +2414,86 @@ def run(cycle: 0.1)
                     Roby.log_exception_with_backtrace(e, Roby, :warn)
                 end
             end
+            flush_exception_display
             @quit = 0
             @allow_propagation = true
         end
 
         attr_reader :last_stop_count # :nodoc:
 
+        # Statistics about a plan teardown, as performed by {#clear}
+        #
+        # @!attribute start_time
+        #   @return [Time] the time of the first call to {#clear}
+        # @!attribute task_count
+        #   @return [Integer] the number of tasks in the plan at that time
+        # @!attribute cycles
+        #   @return [Integer] how many times {#clear} has been called
+        # @!attribute clear_time
+        #   @return [Float] the time spent in {#clear} itself, in seconds
+        # @!attribute gc_time
+        #   @return [Float] the time spent in {#garbage_collect}, in seconds
+        # @!attribute stop_requests
+        #   @return [Integer] the number of tasks on which the garbage
+        #     collection called #stop!
+        TeardownStatistics = Struct.new(
+            :start_time, :task_count, :cycles, :clear_time, :gc_time,
+            :stop_requests
+        ) do
+            # The total time the teardown took so far, in seconds
+            def duration(now = Time.now)
+                now - start_time
+            end
+
+            def to_s
+                format(
+                    "%<task_count>i tasks removed in %<cycles>i cycles and "\
+                    "%<duration>.3fs (clear: %<clear>.3fs, GC: %<gc>.3fs, "\
+                    "%<stop_requests>i stop requests)",
+                    task_count: task_count, cycles: cycles, duration: duration,
+                    clear: clear_time, gc: gc_time, stop_requests: stop_requests
+                )
+            end
+        end
+
+        # Statistics about the teardown currently in progress
+        #
+        # @return [TeardownStatistics,nil]
+        attr_reader :teardown_statistics
+
+        # Statistics about the last complete teardown
+        #
+        # @return [TeardownStatistics,nil]
+        attr_reader :last_teardown_statistics
+
         # Sets up the plan for clearing: it discards all missions and undefines
         # all permanent tasks and events.
         #
         # Returns nil if the plan is cleared, and the set of remaining tasks
         # otherwise. Note that quaranteened tasks are not counted as remaining,
         # as it is not possible for the execution engine to stop them.
+        #
+        # The time spent in the teardown is accounted in
+        # {#teardown_statistics}, which is reported once the plan is cleared
         def clear
+            clear_start = Time.now
+            @teardown_statistics ||= TeardownStatistics.new(
+                clear_start, plan.num_tasks, 0, 0, 0, 0
+            )
+            @teardown_statistics.cycles += 1
+
             plan.mission_tasks.dup.each { |t| plan.unmark_mission_task(t) }
             plan.permanent_tasks.dup.each { |t| plan.unmark_permanent_task(t) }
             plan.permanent_events.dup.each { |t| plan.unmark_permanent_event(t) }
             plan.force_gc.merge(plan.tasks)
 
-            quaranteened_subplan = plan.compute_useful_tasks(plan.quarantined_tasks)
-            remaining = plan.tasks - quaranteened_subplan
+            quarantined_tasks = plan.quarantined_tasks
+            if quarantined_tasks.empty?
+                remaining = plan.tasks.dup
+            else
+                quaranteened_subplan = plan.compute_useful_tasks(quarantined_tasks)
+                remaining = plan.tasks - quaranteened_subplan
+            end
 
             @pending_exceptions.clear
 
@@ -2268,11 +2507,24 @@ def clear
                 end
                 plan.clear
                 emitted_events.clear
+                finish_teardown_statistics(clear_start)
                 return
             end
+            @teardown_statistics.clear_time += Time.now - clear_start
             remaining
         end
 
+        # @api private
+        #
+        # Closes the statistics of the teardown in progress and reports them
+        def finish_teardown_statistics(clear_start)
+            stats = @teardown_statistics
+            @teardown_statistics = nil
+            stats.clear_time += Time.now - clear_start
+            info "teardown: #{stats}"
+            @last_teardown_statistics = stats
+        end
+
         # If set to true, Roby will warn if the GC cannot be controlled by Roby
         attr_predicate :gc_warning?, true
 
@@ -2414,6 +2666,8 @@ def execute_one_cycle(time = Time.now)
             stats[:log_queue_size]   = plan.log_queue_size
             stats[:plan_task_count]  = plan.num_tasks
             stats[:plan_event_count] = plan.num_free_events
+            stats[:poll_count] = poll_scheduler.last_report.polled
+            stats[:poll_time] = poll_scheduler.last_report.duration
             stats[:gc] = GC.stat
             stats[:utime] = process_times.utime - last_process_times.utime
             stats[:stime] = process_times.stime - last_process_times.stime
@@ -2470,6 +2724,7 @@ def force_quit
         # Make a quit EE ready for reuse
         def reset
             @quit = 0
+            @teardown_statistics = nil
         end
 
         # Called at each cycle end
@@ -2626,6 +2881,21 @@ def remove_exception_listener(handler)
             handler.dispose if handler.respond_to?(:dispose)
         end
 
+        # Executor on which exceptions are formatted and logged when
+        # {#display_exceptions?} is set
+        #
+        # When nil (the default), this is done synchronously in the engine
+        # thread. Otherwise, the engine thread only captures a plain copy of
+        # the exception (see {ExceptionSnapshot}) and the names of the involved
+        # tasks. Backtrace filtering, pretty-printing and logging are done on
+        # the executor.
+        #
+        # The executor is shut down, and pending reports flushed, when the
+        # engine quits (see {#flush_exception_display})
+        #
+        # @return [Concurrent::ExecutorService,nil]
+        attr_accessor :exception_display_executor
+
         # Controls whether this engine should indiscriminately display all fatal
         # exceptions
         #
@@ -2643,21 +2913,57 @@ def display_exceptions=(flag)
                         end
 
                 send(level) do
-                    send(level, "encountered a #{kind} exception")
-                    Roby.log_exception_with_backtrace(error.exception, self, level)
-                    if kind == EXCEPTION_HANDLED
-                        send(level, "the exception was handled by")
+                    if (executor = exception_display_executor)
+                        snapshot = ExceptionSnapshot.capture(error.exception)
+                        task_names = tasks.map { |t| t.to_s.dup.freeze }
+                        executor.post do
+                            display_exception(level, kind, snapshot, task_names)
+                        end
                     else
-                        send(level, "the exception involved")
-                    end
-                    tasks.each do |t|
-                        send(level, "  #{t}")
+                        display_exception(level, kind, error.exception, tasks)
                     end
                     break
                 end
             end
         end
 
+        # @api private
+        #
+        # Formats and logs an exception reported to {#notify_exception}
+        #
+        # @param [Symbol] level the log level
+        # @param [Symbol] kind the exception kind, as passed to {#on_exception}
+        # @param [Exception,ExceptionSnapshot] exception the underlying
+        #   exception
+        # @param [Array<#to_s>] tasks the tasks involved in the exception
+        def display_exception(level, kind, exception, tasks)
+            send(level, "encountered a #{kind} exception")
+            Roby.log_exception_with_backtrace(exception, self, level)
+            if kind == EXCEPTION_HANDLED
+                send(level, "the exception was handled by")
+            else
+                send(level, "the exception involved")
+            end
+            tasks.each do |t|
+                send(level, "  #{t}")
+            end
+        end
+
+        # Shuts down {#exception_display_executor} and waits for all pending
+        # exception reports to be logged
+        #
+        # @param [Numeric,nil] timeout how long to wait for pending reports. Nil
+        #   waits forever
+        def flush_exception_display(timeout: nil)
+            return unless (executor = exception_display_executor)
+
+            executor.shutdown
+            unless executor.wait_for_termination(timeout)
+                warn "timed out while waiting for pending exception reports"
+            end
+            @exception_display_executor = nil
+        end
+
         # whether this engine should indiscriminately display all fatal
         # exceptions
         def display_exceptions?
@@ -24,6 +24,13 @@ class PlanRebuilderWidget < Qt::Widget
             # The last processed cycle
             # @return [Integer]
             attr_reader :last_cycle
+            # What changed in {#current_plan} at the last {#apply}
+            #
+            # It is full if the applied snapshot does not directly follow the
+            # one applied before it
+            #
+            # @return [DRoby::PlanChangeSet]
+            attr_reader :applied_changes
 
             # Signal emitted when an informational message is meant to be
             # displayed
@@ -67,6 +74,9 @@ def initialize(parent, plan_rebuilder)
                 @logfile = nil # set by #open
                 @plan_rebuilder = plan_rebuilder
                 @current_plan = DRoby::RebuiltPlan.new
+                @pending_changes = DRoby::PlanChangeSet.new
+                @applied_snapshot = nil
+                @applied_changes = DRoby::PlanChangeSet.full
                 @layout.add_widget(list)
 
                 Qt::Object.connect(list, SIGNAL("currentItemChanged(QListWidgetItem*,QListWidgetItem*)"),
@@ -126,11 +136,20 @@ def add_missing_cycles(count)
                 item.text = "[#{count} cycles missing]" # rubocop:disable Lint/UselessSetterCall
             end
 
-            Snapshot = Struct.new :stats, :plan
+            # A plan snapshot in {#history}
+            #
+            # @!method changes
+            #   @return [DRoby::PlanChangeSet] the changes since the previous
+            #     snapshot
+            # @!method previous
+            #   @return [Snapshot,nil] the previous snapshot in the history
+            Snapshot = Struct.new :stats, :plan, :changes, :previous
 
             def append_to_history
                 snapshot = Snapshot.new plan_rebuilder.stats.dup,
-                                        DRoby::RebuiltPlan.new
+                                        DRoby::RebuiltPlan.new,
+                                        @pending_changes, @last_snapshot
+                @pending_changes = DRoby::PlanChangeSet.new
                 snapshot.plan.merge(plan_rebuilder.plan)
                 if @last_snapshot
                     snapshot.plan.dedupe(@last_snapshot.plan)
@@ -156,6 +175,15 @@ def currentItemChanged(new_item, previous_item)
             end
 
             def apply(snapshot)
+                @applied_changes =
+                    if snapshot.equal?(@applied_snapshot)
+                        DRoby::PlanChangeSet.new
+                    elsif @applied_snapshot && snapshot.previous.equal?(@applied_snapshot)
+                        snapshot.changes
+                    else
+                        DRoby::PlanChangeSet.full
+                    end
+                @applied_snapshot = snapshot
                 @display_time = Time.at(*snapshot.stats[:start]) + snapshot.stats[:end]
                 @current_plan.clear
                 @current_plan.merge(snapshot.plan)
@@ -187,6 +215,7 @@ def push_cycle(snapshot: true)
                 if last_cycle && (cycle != last_cycle + 1)
                     add_missing_cycles(cycle - last_cycle - 1)
                 end
+                @pending_changes.merge(plan_rebuilder.change_set)
                 needs_snapshot =
                     (plan_rebuilder.has_structure_updates? ||
                      plan_rebuilder.has_event_propagation_updates?)
@@ -301,6 +330,11 @@ def connect(client, options = {})
                 end
 
                 @client = client
+                client.on_resync do |skipped|
+                    plan_rebuilder.clear
+                    @pending_changes.full!
+                    emit info("lagging behind, skipped #{skipped} bytes of log")
+                end
                 client.add_listener do |data|
                     plan_rebuilder.clear_integrated
                     plan_rebuilder.process_one_cycle(data)
@@ -309,7 +343,9 @@ def connect(client, options = {})
 
                     cycle = plan_rebuilder.cycle_index
                     time = plan_rebuilder.cycle_start_time
-                    emit info("@#{cycle} - #{time.strftime('%H:%M:%S.%3N')}")
+                    lag = format("%.1f", client.lag || 0)
+                    emit info("@#{cycle} - #{time.strftime('%H:%M:%S.%3N')} "\
+                              "(lag: #{lag}s)")
                 end
                 @connection_pull = timer = Qt::Timer.new(self)
                 timer.connect(SIGNAL("timeout()")) do
@@ -52,7 +52,7 @@ def updateWindowTitle
 
             def setDisplayTime(time)
                 scheduler_view.display(history_widget.current_plan.consolidated_scheduler_state)
-                view.update(time)
+                view.update(time, changes: history_widget.applied_changes)
             end
             slots "setDisplayTime(QDateTime)"
 
@@ -60,7 +60,7 @@ def update_time_range(start_time, current_time); end
 
             def update_display_time(time)
                 scheduler_view.display(history_widget.current_plan.consolidated_scheduler_state)
-                view.update(time)
+                view.update(time, changes: history_widget.applied_changes)
             end
 
             def save_options
@@ -6,6 +6,7 @@
 require "roby/gui/plan_dot_layout"
 require "roby/gui/styles"
 require "roby/gui/task_state_at"
+require "roby/droby/plan_change_set"
 
 module Roby
     module GUI
@@ -515,6 +516,14 @@ def initialize(plans)
                 @hide_finalized    = true
                 @layout_options    = {}
 
+                @known_objects     = Set.new
+                @displayed_objects = Set.new
+                @layout_arrows     = []
+                @laid_out_objects  = nil
+                @layout_label_sizes = {}
+                @layout_options_signature = nil
+                @consumed_changes  = nil
+
                 default_colors = {
                     Roby::TaskStructure::Dependency => "grey",
                     Roby::TaskStructure::PlannedBy => "#32ba21",
@@ -954,9 +963,21 @@ def make_graphics_visible(object)
             # Update the display with new data that has come from the data
             # stream.
             #
+            # The method compares the plans with the state at the last update,
+            # and only creates, removes and changes the visibility of the
+            # items of the objects that changed. The plans are laid out again
+            # only if the given changes, or the display options, affect the
+            # layout (see {#layout_invalidated?}).
+            #
             # It would be too complex at this stage to know if the plan has been
             # updated, so the method always returns true
-            def update(time = nil)
+            #
+            # @param [DRoby::PlanChangeSet,nil] changes the changes done on the
+            #   plans since the last update. If nil, the plans are laid out
+            #   again. A change set is taken into account only once, i.e.
+            #   passing the same change set again is the same as passing an
+            #   empty one
+            def update(time = nil, changes: nil)
                 # Allow time to be a Qt::DateTime object, so that we can make it
                 # a slot
                 if time.kind_of?(Qt::DateTime)
@@ -986,30 +1007,45 @@ def update(time = nil)
                 all_task_events = all_tasks.inject(Set.new) do |all_task_events, task|
                     all_task_events.merge(task.bound_events.values)
                 end
+                known_objects = all_tasks | all_events | all_task_events
+                known_objects.merge(plans)
 
                 # Remove the items for objects that don't exist anymore
-                (graphics.keys.to_set - all_tasks - all_events - all_task_events).each do |obj|
+                graphics.each_key.reject { |obj| known_objects.include?(obj) }.each do |obj|
                     selected_objects.delete(obj)
                     remove_graphics(graphics.delete(obj))
                     clear_arrows(obj)
                 end
 
-                # Create graphics items for all objects that may get displayed
-                # on the canvas
+                # Create graphics items for the objects that appeared since the
+                # last update
+                created_objects = known_objects - @known_objects
                 all_tasks.each do |object|
+                    next unless created_objects.include?(object)
+
                     create_or_get_item(object, true)
                     object.each_event do |ev|
                         create_or_get_item(ev, false)
                     end
                 end
-                all_events.each { |ev| create_or_get_item(ev, true) }
+                all_events.each do |ev|
+                    create_or_get_item(ev, true) if created_objects.include?(ev)
+                end
                 plans.each { |p| create_or_get_item(p, display_plan_bounding_boxes?) }
+                @known_objects = known_objects
 
                 update_visible_objects
 
-                graphics.each do |object, item|
-                    item.visible = displayed?(object)
+                # Only touch the items whose visibility changed
+                displayed_objects =
+                    graphics.each_key.find_all { |object| displayed?(object) }.to_set
+                changed_objects = (displayed_objects ^ @displayed_objects) | created_objects
+                changed_objects.each do |object|
+                    if (item = graphics[object])
+                        item.visible = displayed_objects.include?(object)
+                    end
                 end
+                @displayed_objects = displayed_objects
 
                 RelationsCanvasEventGenerator.priorities.clear
                 event_priority = 0
@@ -1052,32 +1088,46 @@ def update(time = nil)
 
                 [all_tasks, all_events, plans].each do |object_set|
                     object_set.each do |object|
-                        graphics = self.graphics[object]
-                        if graphics.visible?
-                            object.display(self, graphics)
+                        if displayed_objects.include?(object)
+                            object.display(self, graphics[object])
                         end
                     end
                 end
 
-                # Update arrow visibility
-                arrows.each do |(from, to, rel), item|
-                    next unless @enabled_relations.include?(rel)
-
-                    item.visible = (displayed?(from) && displayed?(to))
-                end
-
-                # Layout the graph
-                layouts = plans.find_all(&:root_plan?)
-                    .map do |p|
-                        dot = PlanDotLayout.new
-                        begin
-                            dot.layout(self, p, layout_options)
-                            dot
-                        rescue Exception => e
-                            puts "Failed to lay out the plan: #{e}"
+                # Layout the graph, but only if something that the layout
+                # depends on changed since the last update. Otherwise, reuse
+                # the arrows that represent the task relations
+                if changes&.equal?(@consumed_changes)
+                    changes = DRoby::PlanChangeSet.new
+                else
+                    @consumed_changes = changes
+                end
+
+                if layout_invalidated?(displayed_objects, changes)
+                    layouts = plans.find_all(&:root_plan?)
+                        .map do |p|
+                            dot = PlanDotLayout.new
+                            begin
+                                dot.layout(self, p, layout_options)
+                                dot
+                            rescue Exception => e
+                                puts "Failed to lay out the plan: #{e}"
+                            end
+                        end.compact
+                    layouts.each(&:apply)
+                    @layout_options_signature = layout_options_signature
+                    @laid_out_objects = layout_nodes(displayed_objects)
+                    @layout_label_sizes = @laid_out_objects.each_with_object({}) do |obj, sizes|
+                        sizes[obj] = label_size(obj)
+                    end
+                    @layout_arrows = arrows.keys
+                else
+                    @layout_arrows.each do |id|
+                        if (item = last_arrows.delete(id))
+                            arrows[id] = item
                         end
-                    end.compact
-                layouts.each(&:apply)
+                    end
+                end
 
                 # Display the signals
                 signal_arrow_idx = -1
@@ -1108,6 +1158,72 @@ def update(time = nil)
                 true
             end
 
+            # Whether the plans must be laid out again
+            #
+            # It is the case if the display options changed, if the set of
+            # displayed {#layout_nodes} changed, if a relation used for the
+            # layout changed between displayed objects, or if the label of a
+            # changed object does not have the size it had at the last layout.
+            #
+            # Event propagations do not invalidate the layout: their arrows
+            # are drawn on top of the current one, and the task events they
+            # make visible are not layout nodes.
+            #
+            # @param [Set] displayed_objects the objects that are displayed
+            # @param [DRoby::PlanChangeSet,nil] changes the plan changes since
+            #   the last update, nil if they are unknown
+            def layout_invalidated?(displayed_objects, changes)
+                return true if !@laid_out_objects || !changes || changes.full?
+                return true if layout_options_signature != @layout_options_signature
+                return true if layout_nodes(displayed_objects) != @laid_out_objects
+
+                edge_changed = changes.each_changed_edge.any? do |parent, child, rel|
+                    layout_relation?(rel) &&
+                        displayed_objects.include?(parent) &&
+                        displayed_objects.include?(child)
+                end
+                return true if edge_changed
+
+                changes.changed_objects.any? do |obj|
+                    (size = @layout_label_sizes[obj]) && size != label_size(obj)
+                end
+            end
+
+            # The displayed objects that are nodes of the layout, i.e. the
+            # ones that are not displayed within another object
+            #
+            # @param [Set] displayed_objects
+            # @return [Set]
+            def layout_nodes(displayed_objects)
+                displayed_objects.find_all { |obj| !obj.display_parent }.to_set
+            end
+
+            # The display options the layout depends on
+            #
+            # @return [Array]
+            def layout_options_signature
+                [layout_method, layout_options.dup, enabled_relations.dup,
+                 @layout_relations.dup, show_ownership,
+                 removed_prefixes.dup, hidden_labels.dup]
+            end
+
+            # The size of the label of an object's graphics item
+            #
+            # @return [(Float,Float),nil]
+            def label_size(object)
+                return unless (item = graphics[object])
+
+                rect = if item.respond_to?(:text) then item.text.bounding_rect
+                       else item.bounding_rect
+                       end
+                [rect.width, rect.height]
+            end
+
+            # Forces the next call to {#update} to lay out the plans again
+            def invalidate_layout
+                @laid_out_objects = nil
+            end
+
             def remove_graphics(item, scene = nil)
                 return unless item
 
@@ -1139,6 +1255,11 @@ def clear
                 selected_objects.clear
                 visible_objects.clear
                 flashing_objects.clear
+                @known_objects.clear
+                @displayed_objects.clear
+                @layout_arrows.clear
+                @layout_label_sizes.clear
+                invalidate_layout
                 scene.update(scene.scene_rect)
             end
         end
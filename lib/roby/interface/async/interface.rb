@@ -158,6 +158,10 @@ def initialize(
 
                     @job_monitors = {}
                     @new_job_listeners = []
+                    @new_job_listeners_by_action = {}
+                    @new_job_listener_order = {}
+                    @new_job_listener_seq = 0
+                    @dispatched_job_ids = Set.new
                 end
 
                 # Schedules an async call on the client
@@ -222,6 +226,7 @@ def poll_connection_attempt
                                                              placeholder_task: placeholder_task, task: job_task)
                             end
                         run_hook :on_reachable, jobs
+                        @dispatched_job_ids.clear
                         new_job_listeners.each do |listener|
                             listener.reset
                             run_initial_new_job_hooks_events(listener, jobs)
@@ -246,26 +251,11 @@ def process_message_queues
                     client.ui_event_queue.clear
 
                     finalized_monitors = {}
-                    finalized_jobs = []
+                    finalized_jobs = Set.new
+                    job_info_cache = {}
                     client.job_progress_queue.each do |id, (job_state, job_id, job_name, *args)|
-                        new_job_listeners.each do |listener|
-                            next if listener.seen_job_with_id?(job_id)
-
-                            job =
-                                if job_state == JOB_MONITORED
-                                    JobMonitor.new(
-                                        self, job_id,
-                                        state: job_state,
-                                        placeholder_task: args[0],
-                                        task: args[1])
-                                else
-                                    monitor_job(job_id, start: false)
-                                end
-                            if listener.matches?(job)
-                                listener.call(job)
-                            else
-                                listener.ignored(job)
-                            end
+                        unless new_job_listeners.empty?
+                            dispatch_new_job(job_state, job_id, args, job_info_cache)
                         end
 
                         finalized_jobs << job_id if job_state == JOB_FINALIZED
@@ -285,6 +275,9 @@ def process_message_queues
                     end
                     client.job_progress_queue.clear
 
+                    # The monitors are already indexed by job ID. The monitor
+                    # sets are copied because the exception hooks may start or
+                    # stop monitors for the same job
                     client.exception_queue.each do |id, (kind, exception, tasks, job_ids)|
                         job_ids.each do |job_id|
                             if monitors = job_monitors[job_id]
@@ -306,11 +299,75 @@ def process_message_queues
                         end
                     end
 
-                    finalized_jobs.each do |job_id|
-                        new_job_listeners.each { |l| l.clear_job_id(job_id) }
+                    unless finalized_jobs.empty?
+                        @dispatched_job_ids.subtract(finalized_jobs)
+                        new_job_listeners.each { |l| l.clear_job_ids(finalized_jobs) }
                     end
                 end
 
+                # @api private
+                #
+                # Calls the new job listeners that did not see a given job yet
+                #
+                # Only the listeners that either listen to all jobs or to the
+                # job's action are considered, in the order of registration.
+                # Each of them gets its own job monitor. A job is dispatched
+                # only once, until it is finalized or a new listener is
+                # registered.
+                #
+                # @param [Hash<Integer,Array>] job_info_cache the job
+                #   information already resolved during this poll, used to
+                #   query the remote side only once per job
+                def dispatch_new_job(job_state, job_id, args, job_info_cache = {})
+                    return unless @dispatched_job_ids.add?(job_id)
+
+                    all_actions_listeners = @new_job_listeners_by_action[nil]
+                    has_action_listeners =
+                        @new_job_listeners_by_action.size > (all_actions_listeners ? 1 : 0)
+                    listeners = (all_actions_listeners || [])
+                        .reject { |l| l.seen_job_with_id?(job_id) }
+                    return if listeners.empty? && !has_action_listeners
+
+                    job_info =
+                        if job_state == JOB_MONITORED
+                            [job_state, args[0], args[1]]
+                        else
+                            job_info_cache.fetch(job_id) do
+                                job_info_cache[job_id] = client.find_job_info_by_id(job_id)
+                            end
+                        end
+
+                    job = new_job_monitor(job_id, job_info)
+                    if has_action_listeners &&
+                       (action_listeners = @new_job_listeners_by_action[job.action_name])
+                        action_listeners = action_listeners.reject { |l| l.seen_job_with_id?(job_id) }
+                        unless action_listeners.empty?
+                            listeners = (listeners + action_listeners)
+                                .sort_by { |l| @new_job_listener_order[l] }
+                        end
+                    end
+
+                    listeners.each_with_index do |listener, i|
+                        job = new_job_monitor(job_id, job_info) if i > 0
+                        if listener.matches?(job)
+                            listener.call(job)
+                        else
+                            listener.ignored(job)
+                        end
+                    end
+                end
+
+                # @api private
+                #
+                # Creates a job monitor from the job information returned by
+                # {Roby::Interface::Interface#find_job_info_by_id}
+                def new_job_monitor(job_id, job_info)
+                    job_state, placeholder_task, job_task = job_info
+                    JobMonitor.new(self, job_id, state: job_state,
+                                                 placeholder_task: placeholder_task,
+                                                 task: job_task)
+                end
+
                 def connecting?
                     connection_future
                 end
@@ -394,6 +451,7 @@ def unreachable!
                         end
                     end
                     job_monitors.clear
+                    @dispatched_job_ids.clear
 
                     if client
                         client.close unless client.closed?
@@ -490,11 +548,21 @@ def create_batch
                 end
 
                 def add_new_job_listener(job)
+                    return if @new_job_listener_order.key?(job)
+
                     new_job_listeners << job
+                    @new_job_listener_order[job] = (@new_job_listener_seq += 1)
+                    @dispatched_job_ids.clear
+                    (@new_job_listeners_by_action[job.action_name] ||= []) << job
                 end
 
                 def remove_new_job_listener(job)
+                    return unless @new_job_listener_order.delete(job)
+
                     new_job_listeners.delete(job)
+                    listeners = @new_job_listeners_by_action[job.action_name]
+                    listeners.delete(job)
+                    @new_job_listeners_by_action.delete(job.action_name) if listeners.empty?
                 end
 
                 def add_job_monitor(job)
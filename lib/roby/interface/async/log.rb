@@ -220,6 +220,9 @@ def poll_connection_attempt
                             client.on_init_done do
                                 run_hook :on_init_done
                             end
+                            client.on_resync do
+                                plan_rebuilder.clear
+                            end
                             client.on_data do |data|
                                 plan_rebuilder.process_one_cycle(data)
                                 cycle = plan_rebuilder.cycle_index
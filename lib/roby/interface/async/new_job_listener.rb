@@ -58,6 +58,13 @@ def clear_job_id(job_id)
                     @processed_job_ids.delete(job_id)
                 end
 
+                # Tell the listener that the given jobs have been finalized
+                #
+                # @param [Set<Integer>] job_ids
+                def clear_job_ids(job_ids)
+                    @processed_job_ids.subtract(job_ids)
+                end
+
                 # Tell this listener that the given job was received, but
                 # ignored.
                 #
@@ -17,6 +17,10 @@ class DRobyChannel
             # until it bails out
             attr_reader :max_write_buffer_size
 
+            # The maximum number of bytes gathered from the write queue in a
+            # single write call
+            WRITE_GATHER_SIZE = 1024**2
+
             # This is a workaround for a very bad performance behavior on first
             # load. These classes are auto-loaded and it takes forever to load
             # them in multithreaded contexts.
@@ -51,13 +55,15 @@ def initialize(
                 @marshaller = marshaller
                 @max_write_buffer_size = max_write_buffer_size
                 @read_buffer = String.new
-                @write_buffer = String.new
+                @write_queue = []
+                @write_offset = 0
+                @write_buffer_size = 0
+                @write_gather_buffer = String.new(capacity: WRITE_GATHER_SIZE)
                 @write_thread = nil
             end
 
-            def write_buffer_size
-                @write_buffer.size
-            end
+            # The number of bytes queued for writing
+            attr_reader :write_buffer_size
 
             def to_io
                 io.to_io
@@ -162,7 +168,13 @@ def reset_thread_guard(read_thread = nil, write_thread = nil)
             # Push queued data
             #
             # The write I/O is buffered. This method pushes data stored within
-            # the internal buffer and/or appends new data to it.
+            # the internal queue and/or appends new data to it.
+            #
+            # Queued data is kept as a list of frozen chunks, and the data of
+            # consecutive chunks is gathered (up to {WRITE_GATHER_SIZE} bytes)
+            # in a single write call. A partial write only advances an offset
+            # in the queue, so that the cost of a write does not depend on how
+            # much data is queued.
             #
             # @return [Boolean] true if there is still data left in the buffe,
             #   false otherwise
@@ -174,16 +186,19 @@ def push_write_data(new_bytes = nil)
                           "from #{@write_thread} to #{Thread.current}"
                 end
 
-                @write_buffer.concat(new_bytes) if new_bytes
-                written_bytes = io.syswrite(@write_buffer)
-
-                @write_buffer = @write_buffer[written_bytes..-1]
-                !@write_buffer.empty?
+                queue_write_data(new_bytes) if new_bytes
+                until @write_queue.empty?
+                    data = gather_write_data
+                    written_bytes = io.syswrite(data)
+                    consume_write_queue(written_bytes)
+                    return true if written_bytes < data.bytesize
+                end
+                false
             rescue Errno::EWOULDBLOCK, Errno::EAGAIN
-                if @write_buffer.size > max_write_buffer_size
+                if write_buffer_size > max_write_buffer_size
                     raise ComError,
                           "droby_channel reached an internal buffer size of "\
-                          "#{@write_buffer.size}, which is bigger than the limit "\
+                          "#{write_buffer_size}, which is bigger than the limit "\
                           "of #{max_write_buffer_size}, bailing out"
                 end
             rescue SystemCallError, IOError
@@ -195,6 +210,62 @@ def push_write_data(new_bytes = nil)
                 else raise
                 end
             end
+
+            # @api private
+            #
+            # Append data to the write queue
+            def queue_write_data(bytes)
+                return if bytes.empty?
+
+                unless bytes.frozen? && bytes.encoding == Encoding::BINARY
+                    bytes = bytes.b.freeze
+                end
+                @write_queue << bytes
+                @write_buffer_size += bytes.bytesize
+            end
+
+            # @api private
+            #
+            # Return the data that should be passed to the next write call
+            #
+            # @return [String]
+            def gather_write_data
+                first = @write_queue.first
+                if @write_offset == 0 &&
+                   (@write_queue.size == 1 || first.bytesize >= WRITE_GATHER_SIZE)
+                    return first
+                end
+
+                buffer = @write_gather_buffer.clear
+                buffer << first.byteslice(@write_offset, WRITE_GATHER_SIZE)
+                @write_queue.each_with_index do |chunk, i|
+                    next if i == 0
+
+                    remaining = WRITE_GATHER_SIZE - buffer.bytesize
+                    break if remaining <= 0
+
+                    if chunk.bytesize > remaining
+                        buffer << chunk.byteslice(0, remaining)
+                    else
+                        buffer << chunk
+                    end
+                end
+                buffer
+            end
+
+            # @api private
+            #
+            # Remove written data from the write queue
+            def consume_write_queue(written_bytes)
+                @write_buffer_size -= written_bytes
+                written_bytes += @write_offset
+                while (chunk = @write_queue.first) &&
+                      written_bytes >= chunk.bytesize
+                    written_bytes -= chunk.bytesize
+                    @write_queue.shift
+                end
+                @write_offset = written_bytes
+            end
         end
     end
 end
@@ -651,6 +651,39 @@ def log_dir
             end
             command :log_dir, "the app's log directory",
                     advanced: true
+
+            # Bring the app back to a clean plan so that it can be reused
+            #
+            # The reset is asynchronous. Use {#reset_finished?} to know when
+            # it is done. See {Application#reset_for_reuse} for details.
+            def reset(log_dir: nil, controller: true)
+                app.reset_for_reuse(log_dir: log_dir, controller: controller)
+                nil
+            end
+            command :reset, "clear the plan and state and start a new log directory",
+                    log_dir: "the new log directory, created in the app's base log "\
+                             "directory if not given",
+                    controller: "whether the controller blocks should be run again",
+                    advanced: true
+
+            # Whether the reset started by {#reset} is finished
+            def reset_finished?
+                !app.resetting_for_reuse?
+            end
+            command :reset_finished?, "whether the last reset is finished",
+                    advanced: true
+
+            # Save a checkpoint of the app's jobs
+            #
+            # See {Application#save_plan_checkpoint}
+            def save_plan_checkpoint
+                app.save_plan_checkpoint
+                nil
+            end
+            command :save_plan_checkpoint,
+                    "save the jobs in a checkpoint that can be restored with "\
+                    "'roby run --restore-plan'",
+                    advanced: true
         end
     end
 end
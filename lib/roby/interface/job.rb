@@ -22,6 +22,14 @@ module Interface
             def self.allocate_job_id
                 @@job_id += 1
             end
+
+            # Make sure that {.allocate_job_id} does not return the given ID or
+            # lower ones
+            #
+            # It is used when restoring jobs, e.g. from a plan checkpoint
+            def self.reserve_job_id(job_id)
+                @@job_id = job_id if @@job_id < job_id
+            end
             @@job_id = 0
 
             # Automatically allocate a job ID
@@ -597,6 +597,10 @@ def event(event_name, options = {}, &block)
                     (!old_model || !old_model.terminal?)
 
                 events[new_event.symbol] = new_event
+                # Tasks create their events from the template, make sure it
+                # gets recomputed
+                invalidate_template
+                each_submodel(&:invalidate_template)
                 forward(new_event => :stop) if setup_terminal_handler
                 const_set(event_name.to_s.camelcase(:upper), new_event)
 
@@ -812,12 +816,46 @@ def provided_services
             #
             # If the given polling block raises an exception, the task will be
             # terminated by emitting its +failed+ event.
-            def poll(&block)
+            #
+            # Tasks that do not need to be polled that often can give a period,
+            # in seconds. The block is then called at that period instead (see
+            # {PollScheduler}):
+            #
+            #   class MyTask < Roby::Task
+            #     poll(period: 1) do
+            #       ... check that the process is alive ...
+            #     end
+            #   end
+            #
+            # @param [Float,nil] period the poll period, nil to poll at every
+            #   cycle. It is inherited by submodels.
+            def poll(period: nil, &block)
                 raise ArgumentError, "no block given" unless block_given?
 
+                self.poll_period = period
                 define_method(:poll_handler, &block)
             end
 
+            # Sets the period of the model-level poll block
+            #
+            # @param [Float,nil] period
+            # @see poll
+            def poll_period=(period)
+                @poll_period = PollScheduler.validate_period(period)
+            end
+
+            # The period of the model-level poll block
+            #
+            # @return [Float,nil] the period in seconds, or nil if the block
+            #   is called at every cycle
+            def poll_period
+                if instance_variable_defined?(:@poll_period)
+                    @poll_period
+                elsif supermodel.respond_to?(:poll_period)
+                    supermodel.poll_period
+                end
+            end
+
             # Defines an exception handler.
             #
             # When propagating exceptions, {ExecutionException} goes up in the
@@ -850,6 +888,19 @@ def on_exception(matcher, &handler)
                 exception_handlers.unshift(
                     [matcher, instance_method("exception_handler_#{id}")]
                 )
+                ExceptionHandlerIndex.invalidate
+            end
+
+            # Enumerates the exception handlers of this model that may match
+            # the given exception, in the order of {#each_exception_handler}
+            #
+            # @param [ExecutionException] exception_object
+            # @see ExceptionHandlerIndex
+            def each_candidate_exception_handler(exception_object, &block)
+                @exception_handler_index ||= ExceptionHandlerIndex.new
+                @exception_handler_index
+                    .candidates(exception_object, each_exception_handler) { |m, _| m }
+                    .each(&block)
             end
 
             @@exception_handler_id = 0
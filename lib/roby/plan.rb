@@ -712,6 +712,40 @@ def force_replace(from, to)
         end
 
         def handle_force_replace(from, to)
+            return unless prepare_replacement(from, to)
+
+            # Swap the subplans of +from+ and +to+
+            yield(from, to)
+
+            transfer_replacement_status(from, to)
+        end
+
+        # @api private
+        #
+        # Validates the plans of the two sides of a replacement, adding +to+
+        # to this plan if it is in a template plan
+        #
+        # @return [Boolean] false if there is nothing to replace
+        #   (i.e. from == to), true otherwise
+        def prepare_replacement(from, to)
+            return false unless validate_replacement_plans(from, to)
+
+            add(to) if to.plan.template?
+            true
+        end
+
+        # @api private
+        #
+        # Validates the plans of the two sides of a replacement, without
+        # modifying the plan
+        #
+        # +to+ may be in a template plan, in which case it has to be added
+        # before the replacement is done
+        #
+        # @return [Boolean] false if there is nothing to replace
+        #   (i.e. from == to), true otherwise
+        # @raise [ArgumentError]
+        def validate_replacement_plans(from, to)
             if !from.plan
                 raise ArgumentError,
                       "#{from} has been removed from plan, "\
@@ -725,18 +759,22 @@ def handle_force_replace(from, to)
                       "trying to replace #{from} but its plan "\
                       "is #{from.plan}, expected #{self}"
             elsif to.plan.template?
-                add(to)
+                return true
             elsif to.plan != self
                 raise ArgumentError,
                       "trying to replace #{to} but its plan "\
                       "is #{to.plan}, expected #{self}"
             elsif from == to
-                return
+                return false
             end
+            true
+        end
 
-            # Swap the subplans of +from+ and +to+
-            yield(from, to)
-
+        # @api private
+        #
+        # Transfers the mission/permanent status and the plan services of a
+        # replaced task to its replacement
+        def transfer_replacement_status(from, to)
             if mission_task?(from)
                 add_mission_task(to)
                 replaced(from, to)
@@ -753,38 +791,46 @@ def handle_force_replace(from, to)
 
         def handle_replace(from, to) # :nodoc:
             handle_force_replace(from, to) do
-                # Check that +to+ is valid in all hierarchy relations where
-                # +from+ is a child
-                unless to.fullfills?(*from.fullfilled_model)
-                    models = from.fullfilled_model.first
-                    missing = models.find_all do |m|
-                        !to.fullfills?(m)
-                    end
-                    if missing.empty?
-                        mismatching_argument =
-                            from.fullfilled_model.last.find do |key, expected_value|
-                                to.arguments.set?(key) &&
-                                    (to.arguments[key] != expected_value)
-                            end
-                    end
-
-                    if mismatching_argument
-                        raise InvalidReplace.new(from, to),
-                              "argument mismatch for #{mismatching_argument.first}"
-                    elsif !missing.empty?
-                        raise InvalidReplace.new(from, to),
-                              "missing provided models #{missing.map(&:name).join(', ')}"
-                    else
-                        raise InvalidReplace.new(from, to),
-                              "#{to} does not fullfill #{from}"
-                    end
-                end
+                validate_replacement_models(from, to)
 
                 # Swap the subplans of +from+ and +to+
                 yield(from, to)
             end
         end
 
+        # @api private
+        #
+        # Checks that +to+ is valid in all hierarchy relations where +from+ is
+        # a child
+        #
+        # @raise [InvalidReplace]
+        def validate_replacement_models(from, to)
+            return if to.fullfills?(*from.fullfilled_model)
+
+            models = from.fullfilled_model.first
+            missing = models.find_all do |m|
+                !to.fullfills?(m)
+            end
+            if missing.empty?
+                mismatching_argument =
+                    from.fullfilled_model.last.find do |key, expected_value|
+                        to.arguments.set?(key) &&
+                            (to.arguments[key] != expected_value)
+                    end
+            end
+
+            if mismatching_argument
+                raise InvalidReplace.new(from, to),
+                      "argument mismatch for #{mismatching_argument.first}"
+            elsif !missing.empty?
+                raise InvalidReplace.new(from, to),
+                      "missing provided models #{missing.map(&:name).join(', ')}"
+            else
+                raise InvalidReplace.new(from, to),
+                      "#{to} does not fullfill #{from}"
+            end
+        end
+
         # Representation for a filter used to exclude tasks or graphs from a replacement
         #
         # Relations to excluded tasks are not moved to the replacing task.
@@ -899,6 +945,108 @@ def replace(from, to, filter: ReplacementFilter::Null.new)
             end
         end
 
+        # Replaces several tasks at once
+        #
+        # This is equivalent to calling {#replace_task} for each pair of the
+        # mappings, except that all the replacements happen simultaneously: a
+        # relation between two replaced tasks (or their events) is
+        # transferred to the two replacing tasks. The relation changes of the
+        # whole mapping are computed first, and then applied in a single
+        # {#group_edge_changes} block
+        #
+        # All the pairs are validated before the plan is modified, so the
+        # plan is left untouched if any of them is invalid.
+        #
+        # @param [{Task=>Task}] mappings the replaced tasks and their
+        #   replacements
+        # @param [ReplacementFilter] filter
+        # @raise [ArgumentError] if a task is both replaced and replacing
+        # @raise [InvalidReplace] if one of the replacing tasks does not
+        #   fullfill the task it replaces
+        def replace_tasks(mappings, filter: ReplacementFilter::Null.new)
+            resolved = {}
+            resolved.compare_by_identity
+            mappings.each do |from, to|
+                next unless validate_replacement_plans(from, to)
+
+                validate_replacement_models(from, to)
+                resolved[from] = to
+            end
+            return if resolved.empty?
+
+            if (chained = resolved.each_value.find { |to| resolved.key?(to) })
+                raise ArgumentError,
+                      "#{chained} is both replaced and replacing in the same "\
+                      "call to #replace_tasks"
+            end
+
+            resolved.each_value do |to|
+                add(to) if to.plan.template?
+            end
+
+            added, removed = compute_tasks_replacement(resolved, filter)
+            group_edge_changes do
+                apply_replacement_operations(added, removed)
+            end
+
+            resolved.each do |from, to|
+                from.initialize_task_replacement(to)
+                transfer_replacement_status(from, to)
+            end
+        end
+
+        # @api private
+        #
+        # Computes the relation changes needed by {#replace_tasks}
+        #
+        # The changes are computed for each replacement separately, and then
+        # merged: the objects of the added relations are resolved through
+        # the mappings, and the duplicates are removed.
+        #
+        # @return [(Array,Array)] the added and removed relations, in the
+        #   format expected by {#apply_replacement_operations}
+        def compute_tasks_replacement(mappings, filter)
+            added = {}
+            removed = {}
+            mappings.each do |from, to|
+                task_added, task_removed =
+                    from.compute_task_replacement_operation(to, filter)
+                task_removed.each { |op| removed[op] = true }
+                task_added.each do |graph, parent, child, info|
+                    parent = resolve_task_replacement(mappings, parent)
+                    child  = resolve_task_replacement(mappings, child)
+                    next if parent == child
+
+                    key = [graph, parent, child]
+                    added[key] = info unless added.key?(key)
+                end
+            end
+            added = added.map { |(graph, parent, child), info| [graph, parent, child, info] }
+            [added, removed.keys]
+        end
+
+        # @api private
+        #
+        # Resolves the object that replaces a task or task event in a
+        # {#replace_tasks} mapping
+        def resolve_task_replacement(mappings, object)
+            if (replacement = mappings[object])
+                replacement
+            elsif object.respond_to?(:task) && (replacement = mappings[object.task])
+                replacement.event(object.symbol)
+            else
+                object
+            end
+        end
+
+        # Groups the relation changes done within the block
+        #
+        # In plain plans this only yields. {ExecutablePlan} uses it to log
+        # the changes as a single message
+        def group_edge_changes
+            yield
+        end
+
         # Register a new plan service on this plan
         def add_plan_service(service)
             if service.task.plan != self
@@ -1319,32 +1467,6 @@ def useful_task?(task)
             tasks.include?(task) && !unneeded_tasks.include?(task)
         end
 
-        class UsefulFreeEventVisitor < RGL::DFSVisitor
-            attr_reader :useful_free_events, :task_events, :stack
-            def initialize(graph, task_events, permanent_events)
-                super(graph)
-                @task_events = task_events
-                @useful_free_events = permanent_events.dup
-                @useful = false
-            end
-
-            def useful?
-                @useful
-            end
-
-            def handle_examine_edge(_u, v)
-                if task_events.include?(v) || useful_free_events.include?(v)
-                    color_map[v] = :BLACK
-                    @useful = true
-                end
-                nil
-            end
-
-            def follow_edge?(_u, v)
-                !task_events.include?(v)
-            end
-        end
-
         # @api private
         #
         # Compute the set of events that are "useful" to the plan.
@@ -1352,6 +1474,12 @@ def follow_edge?(_u, v)
         # It contains every event that is connected to an event in
         # {#permanent_events} or to an event on a task in the plan
         #
+        # The free events that are directly connected to a task event, and
+        # the permanent events, are used as seeds of a single traversal of
+        # the free events, which marks the events it reaches as useful. The
+        # traversal goes both ways along the edges of all the (strong) event
+        # relation graphs, but never through task events.
+        #
         # @return [Set<EventGenerator>]
         def compute_useful_free_events
             # Quick path for a very common case
@@ -1360,64 +1488,52 @@ def compute_useful_free_events
             graphs = each_event_relation_graph
                      .find_all { |g| g.root_relation? && !g.weak? }
 
-            seen = Set.new
             result = permanent_events.dup
-            pending_events = free_events.to_a
-            until pending_events.empty?
-                # This basically computes the subplan that contains "seed" and
-                # determines if it is useful or not
-                seed = pending_events.shift
-                next if seen.include?(seed)
-
-                visitors = []
-                graphs.each do |g|
-                    visitors << [
-                        g, UsefulFreeEventVisitor.new(
-                            g, task_events, permanent_events
-                        ),
-                        [seed].to_set
-                    ]
-                    visitors << [
-                        g.reverse,
-                        UsefulFreeEventVisitor.new(
-                            g.reverse, task_events, permanent_events
-                        ),
-                        [seed].to_set
-                    ]
-                end
+            queue = permanent_events.to_a
+            free_events.each do |ev|
+                next if result.include?(ev)
 
-                component = [seed].to_set
-                has_pending_seeds = true
-                while has_pending_seeds
-                    has_pending_seeds = false
-                    visitors.each do |graph, visitor, seeds|
-                        next if seeds.empty?
+                if graphs.any? { |g| connected_to_task_event?(g, ev) }
+                    result << ev
+                    queue << ev
+                end
+            end
 
-                        new_seeds = []
-                        seeds.each do |vertex|
-                            next if visitor.finished_vertex?(vertex)
-                            next unless graph.has_vertex?(vertex)
+            until queue.empty?
+                ev = queue.pop
+                graphs.each do |g|
+                    g.each_out_neighbour(ev) do |v|
+                        next if result.include?(v) || task_events.include?(v)
 
-                            graph.depth_first_visit(vertex, visitor) do |v|
-                                new_seeds << v
-                            end
-                        end
+                        result << v
+                        queue << v
+                    end
+                    g.each_in_neighbour(ev) do |v|
+                        next if result.include?(v) || task_events.include?(v)
 
-                        unless new_seeds.empty?
-                            has_pending_seeds = true
-                            component.merge(new_seeds)
-                            visitors.each { |g, _, s| s.merge(new_seeds) if g != graph }
-                        end
-                        seeds.clear
+                        result << v
+                        queue << v
                     end
                 end
-                seen.merge(component)
-                result.merge(component) if visitors.any? { |_, v, _| v.useful? }
             end
 
             result
         end
 
+        # @api private
+        #
+        # Tests whether an event is directly connected to a task event in the
+        # given event relation graph
+        def connected_to_task_event?(graph, event)
+            graph.each_out_neighbour(event) do |v|
+                return true if task_events.include?(v)
+            end
+            graph.each_in_neighbour(event) do |v|
+                return true if task_events.include?(v)
+            end
+            false
+        end
+
         # Computes the set of events that are useful in the plan Events are
         # 'useful' when they are chained to a task.
         def useful_events
@@ -1606,6 +1722,19 @@ def remove_task!(task, timestamp = Time.now)
             self
         end
 
+        # Remove a set of tasks from the plan
+        #
+        # All the tasks are checked before the first one is removed, so that
+        # the plan is not modified if one of them cannot be. They are then
+        # removed and finalized in order, with the same timestamp.
+        #
+        # @param [Array<Task>] tasks
+        def remove_tasks(tasks, timestamp = Time.now)
+            tasks.each { |t| verify_plan_object_finalization_sanity(t) }
+            tasks.each { |t| remove_task(t, timestamp) }
+            self
+        end
+
         def remove_free_event(event, timestamp = Time.now)
             verify_plan_object_finalization_sanity(event)
             remove_free_event!(event, timestamp)
@@ -0,0 +1,239 @@
+# frozen_string_literal: true
+
+module Roby
+    # A snapshot of the job structure of an executable plan, which can be
+    # saved on disk and restored at startup
+    #
+    # Rebuilding a plan after a restart usually means planning all the jobs
+    # again. A checkpoint instead records the task models, arguments and task
+    # relations of the tasks that are not finished (as well as the planning
+    # tasks of these tasks, which represent the jobs), using the DRoby
+    # marshalling. Restoring it creates new tasks, in a transaction that is
+    # committed only if all tasks could be restored.
+    #
+    # Restored tasks are pending, even if they were running when the
+    # checkpoint was taken. Task models can overload
+    # {Task#restore_from_checkpoint} to re-attach to or re-validate the
+    # external resources they were managing. Planning tasks that were finished
+    # are restored as finished, along with their event history, so that the
+    # jobs are not planned again. The events are not propagated, and their
+    # sources are not restored.
+    #
+    # Relations between task events that are not defined by the task models
+    # are not restored.
+    class PlanCheckpoint
+        # Version of the on-disk format
+        FORMAT_VERSION = 1
+
+        # Exception raised by {.load} when given an invalid file
+        class InvalidFormat < RuntimeError; end
+
+        # Information about a single task
+        #
+        # @!method id
+        #   @return [Integer] the ID used to refer to this task in
+        #     {PlanCheckpoint#relations}
+        # @!method model
+        #   the marshalled task model
+        # @!method arguments
+        #   the marshalled static task arguments
+        # @!method state
+        #   @return [:pending,:running,:success,:failed]
+        # @!method mission
+        #   @return [Boolean]
+        # @!method permanent
+        #   @return [Boolean]
+        # @!method history
+        #   @return [Array<(Symbol,Object,Time)>,nil] the events emitted by
+        #     a finished task, as (event name, marshalled context, time)
+        #     tuples. It is nil for tasks that are not finished
+        TaskRecord = Struct.new :id, :model, :arguments, :state, :mission,
+                                :permanent, :history
+
+        # The time at which the checkpoint was taken
+        #
+        # @return [Time]
+        attr_reader :time
+
+        # The tasks
+        #
+        # @return [Array<TaskRecord>]
+        attr_reader :tasks
+
+        # The task relations, as (relation, parent_id, child_id, info) tuples.
+        # The relation and info are marshalled
+        #
+        # @return [Array<(Object,Integer,Integer,Object)>]
+        attr_reader :relations
+
+        def initialize(time, tasks, relations)
+            @time = time
+            @tasks = tasks
+            @relations = relations
+        end
+
+        # The tasks of a plan that should be recorded in a checkpoint
+        #
+        # @return [Array<Task>]
+        def self.checkpointed_tasks(plan)
+            tasks = plan.tasks.find_all do |t|
+                !t.finished? && !t.failed_to_start?
+            end
+            planning_tasks = tasks.flat_map { |t| t.each_planning_task.to_a }
+            (tasks + planning_tasks).uniq
+        end
+
+        # @api private
+        #
+        # The state recorded for a given task
+        def self.state_of(task)
+            if task.running? then :running
+            elsif task.success? then :success
+            elsif task.finished? then :failed
+            else :pending
+            end
+        end
+
+        # Take a checkpoint of the given plan
+        #
+        # It must be called from within the plan's execution thread
+        #
+        # @param [ExecutablePlan] plan
+        # @return [PlanCheckpoint]
+        def self.capture(plan, time: Time.now)
+            tasks = checkpointed_tasks(plan)
+            ids = {}
+            tasks.each_with_index { |t, i| ids[t] = i }
+
+            records = tasks.map do |t|
+                TaskRecord.new(
+                    ids[t], dump(t.model), dump(t.arguments.assigned_arguments),
+                    state_of(t), t.mission?, plan.permanent_task?(t),
+                    (dump_history(t) if t.finished?)
+                )
+            end
+
+            relations = []
+            plan.each_task_relation_graph do |graph|
+                relation = nil
+                graph.each_edge do |parent, child, info|
+                    next unless (parent_id = ids[parent]) && (child_id = ids[child])
+
+                    relation ||= dump(graph.class)
+                    relations << [relation, parent_id, child_id, dump(info)]
+                end
+            end
+            new(time, records, relations)
+        end
+
+        # @api private
+        #
+        # The event history of a task, as stored in {TaskRecord#history}
+        def self.dump_history(task)
+            task.history.map { |ev| [ev.symbol, dump(ev.context), ev.time] }
+        end
+
+        # @api private
+        #
+        # Marshal a single value
+        #
+        # Each value is marshalled separately, so that it does not refer to
+        # objects marshalled earlier by ID. Models are resolved by name when
+        # the checkpoint is restored.
+        def self.dump(object)
+            DRoby::Marshal.new.dump(object)
+        end
+
+        # @api private
+        #
+        # Unmarshal a value marshalled with {.dump}
+        def self.load_value(marshalled)
+            DRoby::Marshal.new(auto_create_plans: true).local_object(marshalled)
+        end
+
+        # Save this checkpoint in a file
+        #
+        # The file is replaced atomically, so that a crash while saving does
+        # not leave a corrupted checkpoint
+        def save(path)
+            tmp_path = "#{path}.tmp"
+            File.open(tmp_path, "wb") do |io|
+                ::Marshal.dump([FORMAT_VERSION, time, tasks, relations], io)
+            end
+            FileUtils.mv tmp_path, path
+        end
+
+        # Load a checkpoint saved with {#save}
+        #
+        # @return [PlanCheckpoint]
+        # @raise InvalidFormat
+        def self.load(path)
+            version, time, tasks, relations = File.open(path, "rb") do |io|
+                ::Marshal.load(io) # rubocop:disable Security/MarshalLoad
+            end
+            if version != FORMAT_VERSION
+                raise InvalidFormat,
+                      "#{path} is a plan checkpoint of version #{version}, "\
+                      "expected #{FORMAT_VERSION}"
+            end
+            new(time, tasks, relations)
+        end
+
+        # Exception raised when a checkpoint cannot be restored
+        class RestoreFailed < RuntimeError; end
+
+        # Restore this checkpoint in a plan
+        #
+        # It must be called from within the plan's execution thread. Nothing
+        # is added to the plan if any task cannot be restored, i.e. if its
+        # model cannot be resolved or if its {Task#restore_from_checkpoint}
+        # hook returns false.
+        #
+        # @param [ExecutablePlan] plan
+        # @return [Array<Task>] the restored tasks
+        # @raise RestoreFailed
+        def restore(plan)
+            trsc = Transaction.new(plan)
+            restored = tasks.map { |record| restore_task(trsc, record) }
+
+            relations.each do |relation, parent_id, child_id, info|
+                restored[parent_id].add_child_object(
+                    restored[child_id], PlanCheckpoint.load_value(relation),
+                    PlanCheckpoint.load_value(info)
+                )
+            end
+            trsc.commit_transaction
+            restored
+        rescue Exception # rubocop:disable Lint/RescueException
+            trsc.discard_transaction if trsc && !trsc.finalized?
+            raise
+        end
+
+        # @api private
+        #
+        # Create the task for a given task record
+        def restore_task(trsc, record)
+            model = DRoby::Marshal.new.find_local_model(record.model)
+            unless model
+                raise RestoreFailed,
+                      "cannot resolve task model #{record.model.name}"
+            end
+
+            task = model.new(**PlanCheckpoint.load_value(record.arguments))
+            trsc.add(task)
+            if record.history
+                task.restore_event_history(
+                    record.history.map do |symbol, context, time|
+                        [symbol, PlanCheckpoint.load_value(context), time]
+                    end
+                )
+            elsif !task.restore_from_checkpoint(running: record.state == :running)
+                raise RestoreFailed, "#{task} refused to be restored"
+            end
+
+            trsc.add_mission_task(task) if record.mission
+            trsc.add_permanent_task(task) if record.permanent
+            task
+        end
+    end
+end
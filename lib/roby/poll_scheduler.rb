@@ -0,0 +1,175 @@
+# frozen_string_literal: true
+
+module Roby
+    # Calls the poll blocks of the running tasks
+    #
+    # Most poll blocks are called at every execution cycle. Blocks registered
+    # with a period (see {Task#poll} and {Models::Task#poll}) are kept sorted
+    # by deadline, so that they cost nothing until they are due. The first
+    # deadline of a periodic block is picked randomly within its period, so
+    # that tasks started together do not all get polled in the same cycle.
+    #
+    # The amount of poll work done in the last cycle is available in
+    # {#last_report}
+    class PollScheduler
+        # A block registered in the scheduler
+        class Registration
+            # The poll period in seconds, or nil if the block is called at
+            # every cycle
+            #
+            # @return [Float,nil]
+            attr_reader :period
+            # The block itself
+            attr_reader :block
+
+            def initialize(period, block)
+                @period = period
+                @block = block
+                @disposed = false
+            end
+
+            # Deregisters the block
+            def dispose
+                @disposed = true
+            end
+
+            def disposed?
+                @disposed
+            end
+        end
+
+        # The poll work done in a given cycle
+        #
+        # @!method polled
+        #   @return [Integer] the number of blocks that have been called
+        # @!method pending
+        #   @return [Integer] the number of periodic blocks that were not due
+        # @!method duration
+        #   @return [Float] the time spent in the poll blocks, in seconds
+        Report = Struct.new :polled, :pending, :duration
+
+        # The engine this scheduler is part of
+        #
+        # @return [ExecutionEngine]
+        attr_reader :execution_engine
+
+        # The blocks called at every cycle
+        #
+        # @return [Array<Registration>]
+        attr_reader :every_cycle
+
+        # The periodic blocks, sorted by deadline
+        #
+        # @return [Array<(Time,Registration)>]
+        attr_reader :scheduled
+
+        # The random generator used to spread the first deadline of periodic
+        # blocks
+        #
+        # @return [#rand]
+        attr_accessor :random
+
+        # The work done in the last call to {#call}
+        #
+        # @return [Report]
+        attr_reader :last_report
+
+        # @param [Random] random the random generator used to spread the
+        #   first deadline of periodic blocks
+        def initialize(execution_engine, random: Random.new)
+            @execution_engine = execution_engine
+            @random = random
+            @every_cycle = []
+            @scheduled = []
+            @last_report = Report.new(0, 0, 0)
+        end
+
+        # Validates a poll period
+        #
+        # @param [Numeric,nil] period
+        # @return [Float,nil]
+        # @raise ArgumentError if the period is not strictly positive
+        def self.validate_period(period)
+            return unless period
+
+            if period <= 0
+                raise ArgumentError,
+                      "poll period must be strictly positive, got #{period}"
+            end
+            Float(period)
+        end
+
+        # Register a poll block
+        #
+        # @param [Float,nil] period the poll period in seconds. If nil, the
+        #   block is called at every cycle
+        # @return [Registration] an object whose dispose method deregisters
+        #   the block
+        def add(period = nil, &block)
+            period = PollScheduler.validate_period(period)
+            registration = Registration.new(period, block)
+            if period
+                schedule(execution_engine.cycle_start + random.rand * period,
+                         registration)
+            else
+                every_cycle << registration
+            end
+            registration
+        end
+
+        # Whether there are no blocks registered
+        def empty?
+            every_cycle.empty? && scheduled.empty?
+        end
+
+        # @api private
+        #
+        # Insert a periodic block in {#scheduled}
+        def schedule(deadline, registration)
+            index = scheduled.bsearch_index { |t, _| t > deadline }
+            scheduled.insert(index || scheduled.size, [deadline, registration])
+        end
+
+        # Calls the blocks that are due in this cycle
+        #
+        # A periodic block is called if its deadline is closer to the
+        # beginning of this cycle than to the beginning of the next, i.e. the
+        # same rounding than {ExecutionEngine#delayed}
+        #
+        # @return [Report]
+        def call
+            start = Time.now
+            limit = execution_engine.cycle_start + execution_engine.cycle_length / 2
+
+            every_cycle.delete_if(&:disposed?)
+            polled = every_cycle.dup.count { |r| call_registration(r) }
+
+            until scheduled.empty? || scheduled.first[0] >= limit
+                deadline, registration = scheduled.shift
+                next if registration.disposed?
+
+                call_registration(registration)
+                polled += 1
+                deadline += registration.period while deadline < limit
+                schedule(deadline, registration)
+            end
+
+            @last_report = Report.new(polled, scheduled.size, Time.now - start)
+        end
+
+        # @api private
+        #
+        # Call a single block, reporting exceptions as framework errors
+        #
+        # @return [Boolean] true if the block has been called
+        def call_registration(registration)
+            return false if registration.disposed?
+
+            registration.block.call(execution_engine.plan)
+            true
+        rescue Exception => e # rubocop:disable Lint/RescueException
+            execution_engine.add_framework_error(e, "task poll")
+            true
+        end
+    end
+end
@@ -146,6 +146,19 @@ def ===(exception)
                     (@handled.nil? || !(@handled ^ exception.handled?))
             end
 
+            # Cheap pre-filter used by {ExceptionHandlerIndex}
+            #
+            # @param [Class] exception_model the class of the underlying error
+            # @param [Models::Task,nil] origin_model the model of the error's
+            #   failed task, if there is one
+            # @return [Boolean] false if this matcher cannot match an exception
+            #   with these characteristics, true otherwise
+            def may_match?(exception_model, origin_model)
+                return true unless exception_matcher.respond_to?(:may_match?)
+
+                exception_matcher.may_match?(exception_model, origin_model)
+            end
+
             def describe_failed_match(exception)
                 unless exception_matcher === exception.exception
                     return exception_matcher.describe_failed_match(exception.exception)
@@ -83,6 +83,29 @@ def ===(exception)
                 original_exception || true
             end
 
+            # Cheap pre-filter used by {ExceptionHandlerIndex}
+            #
+            # It only looks at the exception class and at the model of the
+            # origin task. It returns true whenever it cannot decide, which
+            # includes plain module models, as the exception object itself
+            # may have been extended with the module.
+            #
+            # @param [Class] exception_model the class of the error
+            # @param [Models::Task,nil] origin_model the model of the error's
+            #   failed task, if there is one
+            def may_match?(exception_model, origin_model)
+                if model.kind_of?(Class) && !(exception_model <= model)
+                    return false
+                end
+
+                matcher = failure_point_matcher
+                if matcher.kind_of?(TaskMatcher) && !matcher.model.empty?
+                    return false unless origin_model
+                    return false unless origin_model.fullfills?(matcher.model)
+                end
+                true
+            end
+
             def describe_failed_match(exception)
                 unless model === exception
                     return "exception model #{exception} does not match #{model}"
@@ -23,10 +23,113 @@ def initialize(with_basic = true, with_children = true, plan = nil)
                     .event_relation_graph_for(EventStructure::SchedulingConstraints)
             end
 
+            # The checks of the basic scheduler
+            alias basic_can_schedule? can_schedule?
+
+            # A decision of {#can_schedule?}, along with the tasks whose
+            # presence in the stack influenced it
+            #
+            # @!method result
+            #   @return [Boolean]
+            # @!method stack_dependencies
+            #   @return [Hash<Roby::Task,Boolean>] the tasks whose presence in
+            #     the stack has been tested during the decision, and whether
+            #     they were present. The decision holds for any stack that
+            #     matches.
+            SchedulingDecision = Struct.new :result, :stack_dependencies do
+                def valid_for?(stack)
+                    stack_dependencies.all? do |task, in_stack|
+                        stack.include?(task) == in_stack
+                    end
+                end
+            end
+
+            def initial_events
+                with_scheduling_decisions { super }
+            end
+
+            # @api private
+            #
+            # Keeps the decisions made by {#can_schedule?} for the duration
+            # of the block
+            #
+            # Tasks that share schedule_as parents are resolved only once.
+            # Calls are re-entrant, the decisions being discarded by the
+            # outermost one.
+            def with_scheduling_decisions
+                return yield if @scheduling_decisions
+
+                begin
+                    @scheduling_decisions = Hash.new { |h, k| h[k] = [] }
+                    @stack_dependencies = []
+                    yield
+                ensure
+                    @scheduling_decisions = nil
+                    @stack_dependencies = nil
+                end
+            end
+
+            # Tests whether a task can be started
+            #
+            # @param [Roby::Task] task
+            # @param [Time] time
+            # @param [#include?] stack the tasks that are being scheduled as
+            #   this task. The temporal constraints that come from them are
+            #   ignored.
             def can_schedule?(task, time = Time.now, stack = [])
-                if task.running?
-                    return true
-                elsif !can_start?(task)
+                return true if task.running?
+
+                with_scheduling_decisions do
+                    stack = stack.to_set
+                    decision = @scheduling_decisions[task].find do |d|
+                        d.valid_for?(stack)
+                    end
+                    decision ||= compute_scheduling_decision(task, time, stack)
+
+                    if (caller_dependencies = @stack_dependencies.last)
+                        caller_dependencies.merge!(decision.stack_dependencies)
+                    end
+                    decision.result
+                end
+            end
+
+            # @api private
+            #
+            # Evaluate {#can_schedule?} and register the resulting decision
+            #
+            # @return [SchedulingDecision]
+            def compute_scheduling_decision(task, time, stack)
+                dependencies = {}
+                @stack_dependencies.push(dependencies)
+                begin
+                    result = evaluate_can_schedule?(task, time, stack)
+                ensure
+                    @stack_dependencies.pop
+                end
+
+                # The task is always in the stack of its own schedule_as
+                # parents
+                dependencies.delete(task)
+                decision = SchedulingDecision.new(result, dependencies)
+                @scheduling_decisions[task] << decision
+                decision
+            end
+
+            # @api private
+            #
+            # Tests whether a task is in the stack, registering the test as
+            # a dependency of the current decision
+            def in_scheduling_stack?(stack, task)
+                in_stack = stack.include?(task)
+                @stack_dependencies.last[task] = in_stack
+                in_stack
+            end
+
+            # @api private
+            #
+            # Actual implementation of {#can_schedule?}
+            def evaluate_can_schedule?(task, time, stack)
+                unless can_start?(task)
                     report_holdoff "cannot be started", task
                     return false
                 end
@@ -36,37 +139,41 @@ def can_schedule?(task, time = Time.now, stack = [])
                 event_filter = lambda do |ev|
                     if ev.respond_to?(:task)
                         ev.task != task &&
-                            !stack.include?(ev.task) &&
-                            !scheduling_constraints_graph.related_tasks?(ev.task, task)
+                            !scheduling_constraints_graph.related_tasks?(ev.task, task) &&
+                            !in_scheduling_stack?(stack, ev.task)
                     else true
                     end
                 end
 
-                meets_constraints = start_event.meets_temporal_constraints?(time, &event_filter)
-                unless meets_constraints
-                    if failed_temporal = start_event.find_failed_temporal_constraint(time, &event_filter)
+                failed_temporal = start_event.find_failed_temporal_constraint(time, &event_filter)
+                failed_occurence = start_event.find_failed_occurence_constraint(true, &event_filter)
+                if failed_temporal || failed_occurence
+                    if failed_temporal
                         report_holdoff "temporal constraints not met (%2: %3)", task, failed_temporal[0], failed_temporal[1]
                     end
-                    if failed_occurence = start_event.find_failed_occurence_constraint(true, &event_filter)
+                    if failed_occurence
                         report_holdoff "occurence constraints not met (%2)", task, failed_occurence
                     end
                     return false
                 end
 
                 start_event.each_backward_scheduling_constraint do |parent|
+                    # Cycle in the schedule_as relation
+                    next if in_scheduling_stack?(stack, parent.task)
+
                     begin
-                        stack.push task
+                        stack << task
                         unless can_schedule?(parent.task, time, stack)
                             report_holdoff "held by a schedule_as constraint with %2", task, parent
                             return false
                         end
                     ensure
-                        stack.pop
+                        stack.delete(task)
                     end
                 end
 
                 if basic_constraints?
-                    if super
+                    if basic_can_schedule?(task, time, stack)
                         true
                     else
                         # Special case: check in Dependency if there are some
@@ -65,6 +65,7 @@ class OpenStruct
         #
         # will not fail
         def initialize(model = nil, attach_to = nil, attach_name = nil)
+            @accessors = {}
             clear
 
             @model = model
@@ -161,6 +162,7 @@ def attach_model
                 when OpenStructModel
                     @members[name] ||= create_subfield(name)
                 end
+                __define_accessors(name)
             end
 
             # Trigger updating the structure whenever the state model is
@@ -169,6 +171,7 @@ def attach_model
                 if value.kind_of?(OpenStructModel)
                     @members[name] ||= create_subfield(name)
                 end
+                __define_accessors(name)
             end
         end
 
@@ -208,7 +211,9 @@ def detach
 
         # Called by a child when #attach is called
         def attach_child(name, obj)
-            @members[name.to_s] = obj
+            name = name.to_s
+            @members[name] = obj
+            __define_accessors(name)
             updated(name, obj)
         end
         protected :detach, :attach_as
@@ -394,6 +399,8 @@ def has_method?(name)
             end
 
             def respond_to?(name, include_private = false) # :nodoc:
+                # The generated accessors exist only as a shortcut
+                return __respond_to__(name) if @accessors.key?(name.to_sym)
                 return true if super
 
                 __respond_to__(name)
@@ -407,6 +414,8 @@ def has_method?(name)
             end
 
             def respond_to?(name) # :nodoc:
+                # The generated accessors exist only as a shortcut
+                return __respond_to__(name) if @accessors.key?(name.to_sym)
                 return true if super
 
                 __respond_to__(name)
@@ -504,17 +513,9 @@ def set(name, *args)
                 value = @filters[nil].call(name, value)
             end
 
-            if has_method?(name)
-                if NOT_OVERRIDABLE_RX =~ name
-                    raise ArgumentError, "#{name} is already defined an cannot be overriden"
-                end
-
-                # Override it
-                singleton_class.class_eval do
-                    define_method(name) do
-                        method_missing(name)
-                    end
-                end
+            override = !@accessors.key?(name.to_sym) && has_method?(name)
+            if override && NOT_OVERRIDABLE_RX =~ name
+                raise ArgumentError, "#{name} is already defined an cannot be overriden"
             end
 
             attach
@@ -527,10 +528,56 @@ def set(name, *args)
             end
 
             @members[name] = value
+            __define_accessors(name, override: override)
             updated(name, value)
             value
         end
 
+        # Sets a field through its writer method, i.e. with
+        #
+        #   struct.name = value
+        #
+        # Subclasses may overload it to restrict the fields that can be
+        # written this way. The default simply calls {#set}
+        def __set(name, value)
+            set(name, value)
+        end
+
+        # @api private
+        #
+        # Defines reader and writer methods for the given field on the
+        # singleton class, so that accessing it does not have to go through
+        # #method_missing
+        #
+        # The accessors are defined once a field is set or declared in the
+        # model, and are never removed. The reader falls back to
+        # #method_missing if the field is not set (anymore), and the writer
+        # calls {#__set}. #respond_to? ignores them.
+        #
+        # @param [Boolean] override whether an existing method with the same
+        #   name should be overriden
+        def __define_accessors(name, override: false)
+            reader = name.to_sym
+            return if @accessors.key?(reader)
+            return if name !~ ACCESSOR_NAME_RX || name =~ FORBIDDEN_NAMES_RX
+            return if !override && has_method?(name)
+
+            writer = :"#{name}="
+            @accessors[reader] = true
+            @accessors[writer] = true
+            define_singleton_method(reader) do |&update|
+                attach
+                if !update && @members.key?(name)
+                    @members[name]
+                else
+                    method_missing(reader, &update)
+                end
+            end
+            define_singleton_method(writer) do |value|
+                __set(name, value)
+            end
+        end
+
         def method_missing(name, *args, &update) # :nodoc:
             if name !~ /^\w+(?:\?|=|!)?$/
                 if name[-1, 1] == "?"
@@ -547,8 +594,7 @@ def method_missing(name, *args, &update) # :nodoc:
             end
 
             if name =~ /^(\w+)=$/
-                ret = set($1, *args)
-                ret
+                __set($1, args.first)
 
             elsif name =~ /^(\w+)\?$/
                 # Test
@@ -571,6 +617,8 @@ def alias(from, to)
         FORBIDDEN_NAMES = %w{marshal each enum to}.map { |str| "^#{str}_" }
         FORBIDDEN_NAMES_RX = /(?:#{FORBIDDEN_NAMES.join("|")})/.freeze
 
+        ACCESSOR_NAME_RX = /^\w+$/.freeze
+
         NOT_OVERRIDABLE = %w{class} + instance_methods(false)
         NOT_OVERRIDABLE_RX = /(?:#{NOT_OVERRIDABLE.join("|")})/.freeze
 
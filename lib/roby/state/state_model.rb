@@ -75,12 +75,9 @@ def resolve_data_sources(object, state)
 
     # Representation of the last known state
     class StateLastValueField < OpenStruct
-        def method_missing(name, *args)
-            if name =~ /=$/
-                raise ArgumentError, "cannot write to a StateLastValueField object"
-            end
-
-            super
+        # Reimplemented from OpenStruct
+        def __set(name, value)
+            raise ArgumentError, "cannot write to a StateLastValueField object"
         end
     end
 
@@ -183,12 +180,12 @@ def attach
         end
 
         # Reimplemented from OpenStruct
-        def method_missing(name, *args)
-            if name =~ /(.*)=$/
-                if data_source = data_sources.get($1)
-                    raise ArgumentError,
-                          "cannot explicitely set a field for which a data source exists"
-                end
+        #
+        # It disables writing state variables for which a data source exists
+        def __set(name, value)
+            if data_sources.get(name)
+                raise ArgumentError,
+                      "cannot explicitely set a field for which a data source exists"
             end
             super
         end
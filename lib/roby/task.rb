@@ -255,15 +255,11 @@ def initialize(plan: TemplatePlan.new, **arguments)
 
             @poll_handlers = []
             @execute_handlers = []
+            @poll_registrations = {}
 
-            initialize_events
-            plan.register_task(self)
             template = self.model.template
-
-            mappings = {}
-            template.events_by_name.each do |name, template_event|
-                mappings[template_event] = bound_events[name]
-            end
+            mappings = initialize_events(template)
+            plan.register_task(self)
             template.copy_relation_graphs_to(plan, mappings)
             apply_terminal_flags(
                 template.terminal_events.map(&mappings.method(:[])),
@@ -322,15 +318,31 @@ def current_state?(state)
 
         # Helper methods which creates all the necessary TaskEventGenerator
         # objects and stores them in the #bound_events map
-        def initialize_events # :nodoc:
+        #
+        # The events are enumerated from the model's template, which is
+        # computed once per model, instead of resolving the model's inherited
+        # event definitions for each new task
+        #
+        # All the events are created here, even the ones that will never be
+        # used: the relation graphs, the propagation, the garbage collection
+        # and DRoby expect every task event to be a plan vertex. Only the
+        # generators' own optional state is allocated on demand (see
+        # {EventGenerator#precondition} and {EventGenerator#when_unreachable})
+        #
+        # @param [Models::Task::Template] template the model template
+        # @return [Hash] the mapping from the template events to the
+        #   task's events
+        def initialize_events(template = model.template) # :nodoc:
             # Create all event generators
             bound_events = {}
-            model.each_event do |ev_symbol, ev_model|
-                ev = TaskEventGenerator.new(self, ev_model)
-                ev.plan = plan
-                bound_events[ev_symbol.to_sym] = ev
+            mappings = {}
+            template.events_by_name.each do |ev_symbol, template_event|
+                ev = TaskEventGenerator.new(self, template_event.model)
+                bound_events[ev_symbol] = ev
+                mappings[template_event] = ev
             end
             @bound_events = bound_events
+            mappings
         end
         private :initialize_events
 
@@ -398,6 +410,7 @@ def initialize_copy(old) # :nodoc:
             @bound_events = {}
             @execute_handlers = old.execute_handlers.dup
             @poll_handlers = old.poll_handlers.dup
+            @poll_registrations = {}
             if m = old.instance_variable_get(:@fullfilled_model)
                 @fullfilled_model = m.dup
             end
@@ -1049,11 +1062,35 @@ def compatible_state?(task)
         # @return [Array<InstanceHandler>]
         attr_reader :execute_handlers
 
+        # An instance-level poll block
+        class PollHandler < InstanceHandler
+            # The poll period in seconds, or nil if the block is called at
+            # every execution cycle
+            #
+            # @return [Float,nil]
+            attr_reader :period
+
+            def initialize(block, copy_on_replace, period: nil)
+                super(block, copy_on_replace)
+                @period = period
+            end
+
+            # Creates an option hash from this poll handler parameters that is
+            # valid for Task#poll
+            def as_options
+                super.merge(period: period)
+            end
+
+            def ==(other)
+                super && other.respond_to?(:period) && period == other.period
+            end
+        end
+
         # @api private
         #
         # The set of instance-level poll blocks
         #
-        # @return [Array<InstanceHandler>]
+        # @return [Array<PollHandler>]
         attr_reader :poll_handlers
 
         # Add a block that is going to be executed once, either at the next
@@ -1073,17 +1110,24 @@ def execute(options = {}, &block)
         # Adds a new poll block on this instance
         #
         # @macro InstanceHandlerOptions
+        # @option options [Float,nil] :period (nil) if set, the block is
+        #   called every that many seconds instead of at every execution
+        #   cycle. See {PollScheduler}
         # @yieldparam [Roby::Task] task the task on which the poll block is
         #   executed. It might be different than the one on which it has been
         #   added because of replacements.
         # @return [Object] an ID that can be used in {#remove_poll_handler}
         def poll(options = {}, &block)
             default_on_replace = abstract? ? :copy : :drop
+            poll_options, options = Kernel.filter_options options, period: nil
             options = InstanceHandler.validate_options(options, on_replace: default_on_replace)
+            period = PollScheduler.validate_period(poll_options[:period])
 
             check_arity(block, 1)
-            @poll_handlers << (handler = InstanceHandler.new(block, (options[:on_replace] == :copy)))
-            ensure_poll_handler_called
+            handler = PollHandler.new(block, (options[:on_replace] == :copy),
+                                      period: period)
+            @poll_handlers << handler
+            ensure_poll_handler_called(period)
             Roby.disposable { @poll_handlers.delete(handler) }
         end
 
@@ -1099,9 +1143,15 @@ def remove_poll_handler(handler)
         #
         # Helper for {#execute} and {#poll} that ensures that the {#do_poll} is
         # called by the execution engine
-        def ensure_poll_handler_called
+        #
+        # @param [Float,nil] period the poll period, nil for blocks that must
+        #   be called at every cycle
+        def ensure_poll_handler_called(period = nil)
             if !transaction_proxy? && running?
-                @poll_handler_id ||= execution_engine.add_propagation_handler(description: "poll block for #{self}", type: :external_events, &method(:do_poll))
+                @poll_registrations[period] ||=
+                    execution_engine.poll_scheduler.add(period) do |plan|
+                        do_poll(plan, period: period)
+                    end
             end
         end
 
@@ -1111,11 +1161,32 @@ def ensure_poll_handler_called
         # Defined empty at this level to allow calling super() unconditionally
         def poll_handler; end
 
+        # Whether this task's model defines a poll block
+        def has_poll_handler?
+            method(:poll_handler).owner != Roby::Task
+        end
+
+        # @api private
+        #
+        # The poll periods for which {#do_poll} must be called
+        #
+        # @return [Array<Float,nil>]
+        def poll_periods
+            periods = poll_handlers.map(&:period)
+            periods << model.poll_period if has_poll_handler?
+            periods << nil if state_machine || !execute_handlers.empty?
+            periods.uniq
+        end
+
         # @api private
         #
         # Internal method used to register the poll blocks in the engine
         # execution cycle
-        def do_poll(plan) # :nodoc:
+        #
+        # @param [Float,nil] period only the poll blocks with this period are
+        #   called. The execute blocks and the state machine are handled
+        #   along with the blocks that have no period.
+        def do_poll(plan, period: nil) # :nodoc:
             return unless self_owned?
             # Don't call if we are terminating
             return if finished?
@@ -1123,18 +1194,20 @@ def do_poll(plan) # :nodoc:
             return if event(:internal_error).emitted?
 
             begin
-                while execute_block = @execute_handlers.pop
-                    execute_block.block.call(self)
+                unless period
+                    while execute_block = @execute_handlers.pop
+                        execute_block.block.call(self)
+                    end
                 end
 
-                poll_handler
+                poll_handler if model.poll_period == period
 
-                if machine = state_machine
+                if !period && (machine = state_machine)
                     machine.do_poll(self)
                 end
 
                 @poll_handlers.each do |poll_block|
-                    poll_block.block.call(self)
+                    poll_block.block.call(self) if poll_block.period == period
                 end
             rescue LocalizedError => e
                 execution_engine.add_error(e)
@@ -1144,21 +1217,18 @@ def do_poll(plan) # :nodoc:
         end
 
         on :start do |ev|
-            engine = execution_engine
-
-            # Register poll:
+            # Register poll, once per poll period:
             #  - single class poll_handler add be class method Task#poll
             #  - additional instance poll_handler added by instance method poll
             #  - polling as defined in state of the state_machine, i.e. substates of running
-            if respond_to?(:poll_handler) || !poll_handlers.empty? || state_machine
-                @poll_handler_id = engine.add_propagation_handler(description: "poll block of #{self}", type: :external_events, &method(:do_poll))
+            poll_periods.each do |period|
+                ensure_poll_handler_called(period)
             end
         end
 
         on :stop do |ev|
-            if @poll_handler_id
-                execution_engine.remove_propagation_handler(@poll_handler_id)
-            end
+            @poll_registrations.each_value(&:dispose)
+            @poll_registrations.clear
         end
 
         # Declares that this fault response table should be made active when
@@ -1231,6 +1301,44 @@ def can_merge?(target)
             arguments.can_semantic_merge?(target.arguments)
         end
 
+        # Hook called when this task is created while restoring a plan
+        # checkpoint (see {PlanCheckpoint#restore})
+        #
+        # The task is not yet in the executable plan, and is pending. Task
+        # models that manage external resources can overload it to re-attach
+        # to the resources that were in use when the checkpoint was taken, or
+        # to check that they are still valid.
+        #
+        # @param [Boolean] running whether the task was running when the
+        #   checkpoint was taken
+        # @return [Boolean] false if the task cannot be restored, in which
+        #   case the whole checkpoint is discarded
+        def restore_from_checkpoint(running: false)
+            true
+        end
+
+        # @api private
+        #
+        # Rebuild the event history of a task without emitting the events
+        #
+        # It is used by {PlanCheckpoint#restore} to restore the tasks that
+        # were finished when the checkpoint was taken. The events are not
+        # propagated, i.e. no handlers are called and no signals or
+        # forwardings are followed. The task must already be included in its
+        # final plan.
+        #
+        # @param [Array<(Symbol,Object,Time)>] events the emitted events, in
+        #   emission order, as (event name, context, time) tuples
+        def restore_event_history(events)
+            events.each do |symbol, context, time|
+                generator = event(symbol)
+                event = generator.new(context, 0, time)
+                generator.history << event
+                generator.instance_eval { @emitted = true }
+                fired_event(event)
+            end
+        end
+
         # "Simply" mark this task as terminated. This is meant to be used on
         # quarantined tasks in tests.
         #
@@ -1265,6 +1373,14 @@ def each_exception_handler(&iterator)
             model.each_exception_handler(&iterator)
         end
 
+        # Lists the exception handlers attached to this task that may match
+        # the given exception
+        #
+        # @see ExceptionHandlerIndex
+        def each_candidate_exception_handler(exception_object, &iterator)
+            model.each_candidate_exception_handler(exception_object, &iterator)
+        end
+
         # @api private
         #
         # Validates that both self and the child object are owned by the local
@@ -1449,7 +1565,14 @@ def compute_subplan_replacement_operation(object, filter)
         def replace_by(object, filter: Plan::ReplacementFilter::Null.new)
             added, removed = compute_task_replacement_operation(object, filter)
             plan.apply_replacement_operations(added, removed)
+            initialize_task_replacement(object)
+        end
 
+        # @api private
+        #
+        # Initializes the task and events replacing this task's, once the
+        # relations have been transferred by {#replace_by}
+        def initialize_task_replacement(object)
             initialize_replacement(object)
             each_event do |event|
                 event.initialize_replacement(nil) { object.event(event.symbol) }
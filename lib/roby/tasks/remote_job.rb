@@ -0,0 +1,170 @@
+# frozen_string_literal: true
+
+require "roby/interface"
+
+module Roby
+    module Tasks
+        # Proxy for a job running on another Roby instance
+        #
+        # The remote instance is a separate Roby application, with its own
+        # plan and its own cycle period. This task talks to it through the
+        # Roby interface (DRoby marshalling over TCP), as a shell would. It
+        # does not share the plans: only the job's state is mirrored
+        # locally, and the remote job's tasks and relations are not visible
+        # in the local plan.
+        #
+        # Starting the task starts the action as a job on the remote instance.
+        # The task then follows the job's state, so that the local plan can
+        # use it as any other task (dependency relations, event forwarding,
+        # ...):
+        #
+        # * start is emitted once the job has been created on the remote
+        #   instance
+        # * remote_started is emitted when the job's task is started
+        # * success and failed are emitted when the job succeeds or fails
+        # * stopping the task kills the remote job. Stop is emitted once the
+        #   remote job is finished
+        # * lost is emitted (and forwarded to failed) if the communication with
+        #   the remote instance breaks, or if the job is dropped on the remote
+        #   instance
+        #
+        # The connection and the job creation are done in a separate thread,
+        # so that a slow or unreachable remote instance does not block the
+        # local execution cycle. The kill request is sent without waiting for
+        # the reply.
+        #
+        # @example depend on a job running on the 'navigation' instance
+        #   nav = Tasks::RemoteJob.new(
+        #       host: "localhost", port: 20202,
+        #       action_name: "goto", action_arguments: { x: 10, y: 0 })
+        #   root.depends_on nav
+        class RemoteJob < Roby::Task
+            # The host of the remote Roby instance
+            argument :host, default: "localhost"
+            # The port of the remote Roby instance's interface
+            argument :port, default: Interface::DEFAULT_PORT
+            # The name of the action that should be started
+            argument :action_name
+            # The arguments of the action
+            argument :action_arguments, default: nil
+
+            # Emitted when the task of the remote job has been started
+            event :remote_started
+
+            # Emitted if the remote job cannot be tracked anymore
+            event :lost
+            forward lost: :failed
+
+            # The client connected to the remote instance
+            #
+            # @return [Interface::Client,nil]
+            attr_reader :client
+
+            # The ID of the job on the remote instance
+            #
+            # @return [Integer,nil]
+            attr_reader :remote_job_id
+
+            # The last known state of the remote job, as one of the
+            # Interface::JOB_* constants
+            #
+            # @return [Symbol,nil]
+            attr_reader :remote_job_state
+
+            # @api private
+            #
+            # Connect to the remote instance
+            #
+            # @return [Interface::Client]
+            def connect
+                Interface.connect_with_tcp_to(host, port)
+            end
+
+            event :start do |_context|
+                start_event.achieve_asynchronously(description: "#{self}#start") do
+                    connect_and_start_job
+                end
+            end
+
+            # @api private
+            #
+            # Connect to the remote instance and start the job
+            #
+            # It is called from a separate thread by the start command. The
+            # connection is closed if the job cannot be started.
+            def connect_and_start_job
+                client = connect
+                begin
+                    job_id = client.start_job(action_name, **(action_arguments || {}))
+                rescue Exception # rubocop:disable Lint/RescueException
+                    client.close unless client.closed?
+                    raise
+                end
+
+                # The client is used from the execution thread from now on
+                client.io.reset_thread_guard
+                @remote_job_id = job_id
+                @client = client
+            end
+
+            poll do
+                poll_remote_job
+            end
+
+            # @api private
+            #
+            # Read the job notifications from the remote instance
+            def poll_remote_job
+                client.poll
+                while (progress = client.pop_job_progress)
+                    _, (state, job_id) = progress
+                    next if job_id != remote_job_id
+                    break if remote_job_state_changed(state)
+                end
+            rescue Interface::ComError => e
+                lost_event.emit(e.message)
+            end
+
+            # @api private
+            #
+            # Update the task based on a new remote job state
+            #
+            # @return [Boolean] true if the task has been terminated
+            def remote_job_state_changed(state)
+                @remote_job_state = state
+                case state
+                when Interface::JOB_STARTED
+                    remote_started_event.emit unless remote_started_event.emitted?
+                    return false
+                when Interface::JOB_SUCCESS
+                    success_event.emit
+                when Interface::JOB_FAILED, Interface::JOB_PLANNING_FAILED
+                    failed_event.emit(state)
+                when Interface::JOB_FINISHED, Interface::JOB_FINALIZED
+                    if stop_event.pending? then stop_event.emit
+                    else failed_event.emit(state)
+                    end
+                when Interface::JOB_DROPPED, Interface::JOB_LOST
+                    lost_event.emit(state)
+                else
+                    return false
+                end
+                true
+            end
+
+            event :stop do |_context|
+                begin
+                    client.async_call([], :kill_job, remote_job_id) do |error, _|
+                        lost_event.emit(error.message) if error && !finished?
+                    end
+                rescue Interface::ComError => e
+                    lost_event.emit(e.message)
+                end
+            end
+
+            on :stop do |_event|
+                client.close unless client.closed?
+            end
+        end
+    end
+end
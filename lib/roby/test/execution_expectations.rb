@@ -567,6 +567,8 @@ def with_execution_engine_setup
             #   "trueish" value)
             def verify(&block)
                 all_propagation_info = ExecutionEngine::PropagationInfo.new
+                # What happened since the expectations were last updated
+                cycle_info = ExecutionEngine::PropagationInfo.new
                 timeout_deadline = Time.now + @timeout
 
                 @execute_blocks << block if block
@@ -585,13 +587,14 @@ def verify(&block)
                             end
                             @poll_blocks.each(&:call)
                         end
-                        all_propagation_info.merge(propagation_info)
+                        cycle_info.merge(propagation_info)
 
                         exceptions = engine.cycle_end({}, raise_framework_errors: false)
-                        all_propagation_info.framework_errors.concat(exceptions)
+                        cycle_info.framework_errors.concat(exceptions)
                     end
 
-                    unmet = find_all_unmet_expectations(all_propagation_info)
+                    all_propagation_info.merge(cycle_info)
+                    unmet = find_all_unmet_expectations(all_propagation_info, cycle_info)
                     unachievable = unmet.find_all do |expectation|
                         expectation.unachievable?(all_propagation_info)
                     end
@@ -604,9 +607,13 @@ def verify(&block)
                         raise Unmet.new(unachievable, all_propagation_info)
                     end
 
+                    # The errors from the previous cycles have already been
+                    # validated, and the expectations only ever accept more
+                    # errors over time
                     if @validate_unexpected_errors
-                        validate_has_no_unexpected_error(all_propagation_info)
+                        validate_has_no_unexpected_error(cycle_info)
                     end
+                    cycle_info = ExecutionEngine::PropagationInfo.new
 
                     remaining_timeout = timeout_deadline - Time.now
                     break if remaining_timeout < 0
@@ -615,7 +622,7 @@ def verify(&block)
                         _, propagation_info = with_execution_engine_setup do
                             engine.join_all_waiting_work(timeout: remaining_timeout)
                         end
-                        all_propagation_info.merge(propagation_info)
+                        cycle_info.merge(propagation_info)
                     elsif !has_pending_execute_blocks? && unmet.empty?
                         break
                     end
@@ -625,7 +632,8 @@ def verify(&block)
                                  (engine.has_waiting_work? && @join_all_waiting_work)
                 end
 
-                unmet = find_all_unmet_expectations(all_propagation_info)
+                all_propagation_info.merge(cycle_info)
+                unmet = find_all_unmet_expectations(all_propagation_info, cycle_info)
                 raise Unmet.new(unmet, all_propagation_info) unless unmet.empty?
 
                 if @validate_unexpected_errors
@@ -697,12 +705,62 @@ def unexpected_error?(error)
                 true
             end
 
-            def find_all_unmet_expectations(all_propagation_info)
+            # Update the expectations and return the ones that are not met
+            #
+            # @param [ExecutionEngine::PropagationInfo] all_propagation_info
+            #   everything that happened since the beginning of {#verify}
+            # @param [ExecutionEngine::PropagationInfo] cycle_info what
+            #   happened since the last call. It must be included in
+            #   all_propagation_info
+            # @return [Array<Expectation>]
+            def find_all_unmet_expectations(
+                all_propagation_info, cycle_info = all_propagation_info
+            )
+                delta = PropagationDelta.new(cycle_info)
                 @expectations.find_all do |exp|
-                    !exp.update_match(all_propagation_info)
+                    if exp.respond_to?(:update_match_incremental)
+                        !exp.update_match_incremental(all_propagation_info, delta)
+                    else
+                        !exp.update_match(all_propagation_info)
+                    end
                 end
             end
 
+            # @api private
+            #
+            # What happened since the last time the expectations were
+            # updated, with the emitted events indexed by generator
+            #
+            # The index is computed once, on first use, and shared by all the
+            # expectations
+            class PropagationDelta
+                # @return [ExecutionEngine::PropagationInfo]
+                attr_reader :propagation_info
+
+                def initialize(propagation_info)
+                    @propagation_info = propagation_info
+                    @emitted_events_by_generator = nil
+                end
+
+                # The emitted events
+                #
+                # @return [Set<Event>]
+                def emitted_events
+                    propagation_info.emitted_events
+                end
+
+                # The events emitted by the given generator, in emission order
+                #
+                # @return [Array<Event>]
+                def emitted_events_for(generator)
+                    @emitted_events_by_generator ||=
+                        propagation_info.emitted_events.group_by(&:generator)
+                    @emitted_events_by_generator.fetch(generator, EMPTY_ARRAY)
+                end
+
+                EMPTY_ARRAY = [].freeze
+            end
+
             # @api private
             # Null implementation of an expectation
             class Expectation
@@ -720,6 +778,20 @@ def update_match(_propagation_info)
                     true
                 end
 
+                # Verifies whether the expectation is met at this point, given
+                # what happened since the last call
+                #
+                # The default calls {#update_match} with the whole propagation
+                # info. Expectations that can maintain their own state should
+                # overload it to process only the delta, as the accumulated
+                # propagation info grows with each cycle
+                #
+                # @param [ExecutionEngine::PropagationInfo] all_propagation_info
+                # @param [PropagationDelta] _delta
+                def update_match_incremental(all_propagation_info, _delta)
+                    update_match(all_propagation_info)
+                end
+
                 def unachievable?(_propagation_info)
                     false
                 end
@@ -779,6 +851,11 @@ def update_match(propagation_info)
                     @emitted_events.empty?
                 end
 
+                def update_match_incremental(_all_propagation_info, delta)
+                    (@emitted_events ||= []).concat(delta.emitted_events_for(@generator))
+                    @emitted_events.empty?
+                end
+
                 def unachievable?(_propagation_info)
                     !@emitted_events.empty?
                 end
@@ -808,22 +885,35 @@ def to_s
                 end
 
                 def update_match(propagation_info)
-                    @emitted_events =
-                        propagation_info
-                        .emitted_events
-                        .find_all do |ev|
-                            next unless @event_query === ev.generator
-
-                            @generators << ev.generator
-                            @related_error_matchers <<
-                                Queries::LocalizedErrorMatcher
-                                .new
-                                .with_origin(ev.generator)
-                                .to_execution_exception_matcher
-                        end
+                    @generators = []
+                    @related_error_matchers = []
+                    @emitted_events = []
+                    add_matching_events(propagation_info.emitted_events)
                     @emitted_events.empty?
                 end
 
+                def update_match_incremental(_all_propagation_info, delta)
+                    add_matching_events(delta.emitted_events)
+                    @emitted_events.empty?
+                end
+
+                # @api private
+                #
+                # Register the events that match the query
+                def add_matching_events(events)
+                    events.each do |ev|
+                        next unless @event_query === ev.generator
+
+                        @emitted_events << ev
+                        @generators << ev.generator
+                        @related_error_matchers <<
+                            Queries::LocalizedErrorMatcher
+                            .new
+                            .with_origin(ev.generator)
+                            .to_execution_exception_matcher
+                    end
+                end
+
                 def unachievable?(_propagation_info)
                     !@emitted_events.empty?
                 end
@@ -853,22 +943,35 @@ def to_s
                 end
 
                 def update_match(propagation_info)
-                    @emitted_events =
-                        propagation_info
-                        .emitted_events
-                        .find_all do |ev|
-                            next unless @event_query === ev.generator
-
-                            @generators << ev.generator
-                            @related_error_matchers <<
-                                Queries::LocalizedErrorMatcher
-                                .new
-                                .with_origin(ev.generator)
-                                .to_execution_exception_matcher
-                        end
+                    @generators = []
+                    @related_error_matchers = []
+                    @emitted_events = []
+                    add_matching_events(propagation_info.emitted_events)
                     !@emitted_events.empty?
                 end
 
+                def update_match_incremental(_all_propagation_info, delta)
+                    add_matching_events(delta.emitted_events)
+                    !@emitted_events.empty?
+                end
+
+                # @api private
+                #
+                # Register the events that match the query
+                def add_matching_events(events)
+                    events.each do |ev|
+                        next unless @event_query === ev.generator
+
+                        @emitted_events << ev
+                        @generators << ev.generator
+                        @related_error_matchers <<
+                            Queries::LocalizedErrorMatcher
+                            .new
+                            .with_origin(ev.generator)
+                            .to_execution_exception_matcher
+                    end
+                end
+
                 def return_object
                     @emitted_events
                 end
@@ -903,6 +1006,11 @@ def update_match(propagation_info)
                     !@emitted_events.empty?
                 end
 
+                def update_match_incremental(_all_propagation_info, delta)
+                    (@emitted_events ||= []).concat(delta.emitted_events_for(@generator))
+                    !@emitted_events.empty?
+                end
+
                 def return_object
                     @emitted_events.first
                 end
@@ -925,15 +1033,29 @@ def initialize(matcher, backtrace)
                     super(backtrace)
                     @matcher = matcher.to_execution_exception_matcher
                     @matched_execution_exceptions = []
-                    @matched_exceptions = []
+                    @matched_exceptions = Set.new
                 end
 
                 def update_match(exceptions, emitted_events)
-                    @matched_execution_exceptions =
+                    @matched_execution_exceptions = []
+                    @matched_exceptions = Set.new
+                    add_matches(exceptions, emitted_events)
+                end
+
+                # @api private
+                #
+                # Register the exceptions that match, either given explicitly
+                # or reported by internal_error events
+                #
+                # @return [Boolean] whether at least one exception matched so
+                #   far
+                def add_matches(exceptions, emitted_events)
+                    matched_execution_exceptions =
                         exceptions
                         .find_all { |error| @matcher === error }
+                    @matched_execution_exceptions.concat(matched_execution_exceptions)
                     matched_exceptions =
-                        @matched_execution_exceptions
+                        matched_execution_exceptions
                         .map(&:exception).to_set
 
                     emitted_events.each do |ev|
@@ -948,9 +1070,9 @@ def update_match(exceptions, emitted_events)
                         end
                     end
 
-                    @matched_exceptions = matched_exceptions.flat_map do |e|
-                        Roby.flatten_exception(e).to_a
-                    end.to_set
+                    matched_exceptions.each do |e|
+                        @matched_exceptions.merge(Roby.flatten_exception(e))
+                    end
                     !@matched_exceptions.empty?
                 end
 
@@ -971,6 +1093,10 @@ def update_match(propagation_info)
                     super(propagation_info.exceptions, propagation_info.emitted_events)
                 end
 
+                def update_match_incremental(_all_propagation_info, delta)
+                    add_matches(delta.propagation_info.exceptions, delta.emitted_events)
+                end
+
                 def to_s
                     "should have an error matching #{@matcher}"
                 end
@@ -982,6 +1108,11 @@ def update_match(propagation_info)
                           propagation_info.emitted_events)
                 end
 
+                def update_match_incremental(_all_propagation_info, delta)
+                    add_matches(delta.propagation_info.handled_errors.map(&:first),
+                                delta.emitted_events)
+                end
+
                 def to_s
                     "should have handled an error matching #{@matcher}"
                 end
@@ -1125,6 +1256,7 @@ class HaveFrameworkError < Expectation
                 def initialize(error_matcher, backtrace)
                     super(backtrace)
                     @error_matcher = error_matcher
+                    @matched_exceptions = []
                 end
 
                 def update_match(propagation_info)
@@ -1135,6 +1267,15 @@ def update_match(propagation_info)
                     !@matched_exceptions.empty?
                 end
 
+                def update_match_incremental(_all_propagation_info, delta)
+                    @matched_exceptions.concat(
+                        delta.propagation_info
+                             .framework_errors.map(&:first)
+                             .find_all { |e| @error_matcher === e }
+                    )
+                    !@matched_exceptions.empty?
+                end
+
                 def relates_to_error?(error)
                     @matched_exceptions.include?(error)
                 end
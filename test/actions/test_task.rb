@@ -42,6 +42,17 @@ def test_it_commits_the_transaction_if_the_action_is_successful
             .to { emit task.success_event }
     end
 
+    def test_result_is_the_planned_task_if_restored_finished
+        time = Time.now
+        execute do
+            task.restore_event_history(
+                [[:start, nil, time], [:success, nil, time], [:stop, nil, time]]
+            )
+        end
+        assert task.success?
+        assert_equal task.planned_task, task.result
+    end
+
     def test_it_emits_success_if_the_action_is_successful
         expect_execution { task.start! }
             .to { emit task.success_event }
@@ -216,6 +216,80 @@ def roby_start(*args, log_dir: roby_log_dir, **options)
                     end
                 end
 
+                describe "with a controller pool" do
+                    attr_reader :pool
+
+                    before do
+                        @pool = ControllerPool.new(
+                            size: 1, out: "/dev/null", err: "/dev/null"
+                        )
+                        @controller = Controller.new(pool: pool)
+                    end
+
+                    after do
+                        ensure_roby_controller_stopped
+                        pool.shutdown
+                    end
+
+                    it "takes a process from the pool and replenishes it" do
+                        roby_start("default", "default", app_dir: roby_app_dir)
+                        assert controller.roby_connected?
+                        assert_equal 1, pool.idle_processes.size
+                        refute_equal controller.roby_pid,
+                                     pool.idle_processes.first.pid
+                    end
+
+                    it "gives the process back to the pool on #roby_stop" do
+                        pid = roby_start("default", "default", app_dir: roby_app_dir)
+                        controller.roby_stop
+                        refute controller.roby_running?
+                        assert_includes pool.idle_processes.map(&:pid), pid
+                        assert_equal 1, pool.idle_processes.size
+                    end
+
+                    it "reuses a process given back to the pool" do
+                        pid = roby_start("default", "default", app_dir: roby_app_dir)
+                        controller.roby_stop
+                        assert_equal pid, roby_start(
+                            "default", "default", app_dir: roby_app_dir
+                        )
+                        assert controller.roby_connected?
+                    end
+
+                    it "resets the process' plan and log dir when taking it" do
+                        robot_default_path =
+                            File.join(roby_app_dir, "config", "robots", "default.rb")
+                        File.open(robot_default_path, "w") do |io|
+                            io.puts <<-EOACTION
+                            require "roby/tasks/simple"
+                            class CucumberTestActions < Roby::Actions::Interface
+                                describe("the test action")
+                                    .returns(Roby::Tasks::Simple)
+                                def cucumber_action
+                                    Roby::Tasks::Simple.new
+                                end
+                            end
+                            Robot.actions { use_library CucumberTestActions }
+                            EOACTION
+                        end
+                        roby_start("default", "default", app_dir: roby_app_dir)
+                        controller.roby_interface.client.cucumber_action!
+                        refute_empty controller.roby_interface.client.jobs
+                        controller.roby_stop
+                        log_dir = make_tmpdir
+                        roby_start("default", "default",
+                                   app_dir: roby_app_dir, log_dir: log_dir)
+                        assert_equal log_dir, controller.roby_log_dir
+                        assert_empty controller.roby_interface.client.jobs
+                    end
+
+                    it "does not give back a process that has been killed" do
+                        pid = roby_start("default", "default", app_dir: roby_app_dir)
+                        controller.roby_kill
+                        refute_includes pool.idle_processes.map(&:pid), pid
+                    end
+                end
+
                 describe "handling of actions" do
                     before do
                         robot_default_path =
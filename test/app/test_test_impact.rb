@@ -0,0 +1,178 @@
+# frozen_string_literal: true
+
+require "roby/test/self"
+
+module Roby
+    module App
+        describe TestImpact do
+            attr_reader :dir, :app
+
+            before do
+                @dir = make_tmpdir
+                @app = flexmock
+                app.should_receive(:definition_files_for).and_return([]).by_default
+                app.should_receive(:app_dir).and_return(nil).by_default
+            end
+
+            def create_file(name, content = "")
+                path = File.join(dir, name)
+                FileUtils.mkdir_p File.dirname(path)
+                File.write(path, content)
+                path
+            end
+
+            def define_model(name, path, parent = Roby::Task)
+                m = parent.new_submodel(name: name)
+                app.should_receive(:definition_files_for).with(m).and_return([path])
+                m
+            end
+
+            describe ".from_app" do
+                it "registers the files defining the tested models" do
+                    model_path = create_file("task.rb")
+                    task_m = define_model("Task", model_path)
+                    impact = TestImpact.from_app(app, "test_task.rb" => Set[task_m])
+                    assert_equal [TestImpact::Dependency.new(model_path, "Task is defined there")],
+                                 impact.dependencies["test_task.rb"].to_a
+                end
+
+                it "registers the files defining the parent models" do
+                    parent_path = create_file("parent.rb")
+                    parent_m = define_model("Parent", parent_path)
+                    task_m = define_model("Task", create_file("task.rb"), parent_m)
+                    impact = TestImpact.from_app(app, "test_task.rb" => Set[task_m])
+                    assert impact.dependencies["test_task.rb"].include?(
+                        TestImpact::Dependency.new(
+                            parent_path, "Task is a submodel of Parent, defined there"
+                        )
+                    )
+                end
+
+                it "registers the files defining the provided services" do
+                    srv_path = create_file("srv.rb")
+                    srv_m = TaskService.new_submodel(name: "Srv")
+                    app.should_receive(:definition_files_for).with(srv_m).and_return([srv_path])
+                    task_m = define_model("Task", create_file("task.rb"))
+                    task_m.provides srv_m
+                    impact = TestImpact.from_app(app, "test_task.rb" => Set[task_m])
+                    assert impact.dependencies["test_task.rb"].include?(
+                        TestImpact::Dependency.new(srv_path, "Task provides Srv, defined there")
+                    )
+                end
+
+                it "registers the files defining the models returned by actions" do
+                    task_path = create_file("task.rb")
+                    task_m = define_model("Task", task_path)
+                    interface_m = Actions::Interface.new_submodel(name: "Main") do
+                        describe("action").returns(task_m)
+                        define_method(:action) {}
+                    end
+                    impact = TestImpact.from_app(app, "test_main.rb" => Set[interface_m])
+                    assert impact.dependencies["test_main.rb"].include?(
+                        TestImpact::Dependency.new(
+                            task_path, "action action of Main returns Task, which "\
+                                       "depends on Task defined there"
+                        )
+                    )
+                end
+
+                it "registers test files without models" do
+                    impact = TestImpact.from_app(app, "test_lib.rb" => Set.new)
+                    assert_equal Set.new, impact.dependencies["test_lib.rb"]
+                end
+
+                it "registers the app files that are neither models nor tests "\
+                   "as global dependencies" do
+                    app.should_receive(:app_dir).and_return(dir)
+                    lib_path = create_file("lib/helper.rb")
+                    test_helper_path = create_file("test/helpers.rb")
+                    create_file("models/task.rb")
+                    create_file("test/test_task.rb")
+                    impact = TestImpact.from_app(app, {})
+                    assert_equal [lib_path, test_helper_path].sort,
+                                 impact.global_dependencies.map(&:path).sort
+                end
+            end
+
+            describe "#select" do
+                attr_reader :test_path, :model_path, :impact
+
+                before do
+                    @test_path = create_file("test_task.rb")
+                    @model_path = create_file("task.rb")
+                    @impact = TestImpact.new
+                    impact.add(test_path, model_path, "Task is defined there")
+                    impact.update_digests
+                end
+
+                def reload(path)
+                    impact.save(path)
+                    TestImpact.load(path)
+                end
+
+                it "selects all test files if there is no previous run" do
+                    assert_equal({ test_path => ["no test impact information from a previous run"] },
+                                 TestImpact.new(impact.dependencies).select(nil))
+                end
+
+                it "does not select test files whose dependencies did not change" do
+                    previous = reload(File.join(dir, "cache.yml"))
+                    current = TestImpact.new(impact.dependencies)
+                    assert_equal({}, current.select(previous))
+                end
+
+                it "selects a test file that changed" do
+                    previous = reload(File.join(dir, "cache.yml"))
+                    File.write(test_path, "changed")
+                    current = TestImpact.new(impact.dependencies)
+                    assert_equal({ test_path => ["the test file changed"] },
+                                 current.select(previous))
+                end
+
+                it "selects a test file whose dependency changed and reports why" do
+                    previous = reload(File.join(dir, "cache.yml"))
+                    File.write(model_path, "changed")
+                    current = TestImpact.new(impact.dependencies)
+                    assert_equal({ test_path => ["#{model_path} changed: Task is defined there"] },
+                                 current.select(previous))
+                end
+
+                it "selects a test file if a dependency from the previous run changed" do
+                    previous = reload(File.join(dir, "cache.yml"))
+                    File.write(model_path, "changed")
+                    current = TestImpact.new
+                    current.add_test_file(test_path)
+                    assert_equal({ test_path => ["#{model_path} changed: Task is defined there"] },
+                                 current.select(previous))
+                end
+
+                it "selects all test files if a global dependency changed" do
+                    lib_path = create_file("helper.rb")
+                    impact.add_global(lib_path, "it is not a model file")
+                    impact.update_digests
+                    previous = reload(File.join(dir, "cache.yml"))
+                    File.write(lib_path, "changed")
+                    current = TestImpact.new(impact.dependencies,
+                                             global_dependencies: impact.global_dependencies)
+                    assert_equal({ test_path => ["#{lib_path} changed: it is not a model file"] },
+                                 current.select(previous))
+                end
+
+                it "selects a test file with a new dependency" do
+                    previous = reload(File.join(dir, "cache.yml"))
+                    other_path = create_file("other.rb")
+                    current = TestImpact.new(impact.dependencies.dup)
+                    current.add(test_path, other_path, "Other is defined there")
+                    assert_equal({ test_path => ["#{other_path} changed: Other is defined there"] },
+                                 current.select(previous))
+                end
+            end
+
+            describe ".load" do
+                it "returns nil if the file does not exist" do
+                    assert_nil TestImpact.load(File.join(dir, "does_not_exist"))
+                end
+            end
+        end
+    end
+end
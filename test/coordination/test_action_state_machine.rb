@@ -354,6 +354,97 @@ def state_machine(name, &block)
                 assert_equal :start, task.current_task_child.arguments[:id]
             end
 
+            describe "speculative preparation" do
+                before do
+                    action_m.state_machine "test" do
+                        monitor = state monitoring_task
+                        depends_on monitor, role: "monitor"
+                        start_state = state start_task
+                        next_state = state next_task
+                        start(start_state)
+                        transition(start_state, monitor.success_event, next_state)
+                        prepare_ahead next_state
+                    end
+                    @task = start_machine(action_m.test)
+                    @machine = @task.each_coordination_object.first
+                end
+
+                it "prepares the target states during the engine's side work" do
+                    assert @machine.prepared_states.empty?
+                    execution_engine.execute_side_work
+                    assert_equal 1, @machine.prepared_states.size
+                    prepared = @machine.prepared_states.each_value.first
+                    prepared_task = prepared.tasks.each_value.first
+                    assert_equal Hash[id: :next], prepared_task.arguments
+                    refute plan.has_task?(prepared_task)
+                end
+
+                it "commits the preparation when the transition is taken" do
+                    execution_engine.execute_side_work
+                    prepared = @machine.prepared_states.each_value.first
+                    prepared_task = prepared.tasks.each_value.first
+                    execute do
+                        @task.monitor_child.start!
+                        @task.monitor_child.success_event.emit
+                    end
+                    assert_same prepared_task, @task.current_task_child
+                    assert @machine.prepared_states.empty?
+                end
+
+                it "discards the preparation when the root task stops" do
+                    execution_engine.execute_side_work
+                    prepared = @machine.prepared_states.each_value.first
+                    flexmock(prepared.transaction)
+                        .should_receive(:discard_transaction).once.pass_thru
+                    plan.unmark_permanent_task(@task)
+                    execute { @task.stop! }
+                    assert @machine.prepared_states.empty?
+                end
+
+                it "uses the planned task instead of a placeholder with a planning task" do
+                    refute_nil @task.current_task_child.planning_task
+                    execution_engine.execute_side_work
+                    execute do
+                        @task.monitor_child.start!
+                        @task.monitor_child.success_event.emit
+                    end
+                    assert_nil @task.current_task_child.planning_task
+                    assert_equal Hash[id: :next], @task.current_task_child.arguments
+                end
+
+                it "logs preparation errors and instanciates the state normally" do
+                    flexmock(@machine).should_receive(:prepare_state)
+                                      .and_raise(RuntimeError.new("preparation failed"))
+                    messages = capture_log(Roby, :warn) do
+                        execution_engine.execute_side_work
+                    end
+                    assert(messages.any? { |m| m.start_with?("failed to prepare the state") },
+                           "#{messages} does not report the preparation failure")
+                    assert(messages.any? { |m| m.include?("preparation failed") },
+                           "#{messages} does not include the error")
+
+                    execute do
+                        @task.monitor_child.start!
+                        @task.monitor_child.success_event.emit
+                    end
+                    refute_nil @task.current_task_child.planning_task
+                    assert_equal Hash[id: :next], @task.current_task_child.arguments
+                end
+
+                it "falls back to the normal instanciation if the variables changed" do
+                    execution_engine.execute_side_work
+                    prepared = @machine.prepared_states.each_value.first
+                    prepared.variables = prepared.variables.merge(changed: true)
+                    prepared_task = prepared.tasks.each_value.first
+                    execute do
+                        @task.monitor_child.start!
+                        @task.monitor_child.success_event.emit
+                    end
+                    refute_same prepared_task, @task.current_task_child
+                    assert_equal Hash[id: :next], @task.current_task_child.arguments
+                end
+            end
+
             describe "the capture functionality" do
                 def action_interface
                     start_task_m = Roby::Task.new_submodel(name: "Start") do
@@ -331,6 +331,15 @@ def self.event_source_as_child_behaviour(context)
                             .to { emit task.stop_event }
                     end
 
+                    it "disposes of the timer once the sub-script finished" do
+                        Timecop.freeze(Time.now)
+                        expect_execution { task.start! }.to { not_emit task.stop_event }
+                        refute execution_engine.delayed_blocks.empty?
+                        expect_execution { task.intermediate_event.emit }
+                            .to { emit task.stop_event }
+                        assert execution_engine.delayed_blocks.all? { |_, h| h.disposed? }
+                    end
+
                     it "emits the timeout event and moves on if the sub-script has "\
                         "not finished in time" do
                         Timecop.freeze(base_time = Time.now)
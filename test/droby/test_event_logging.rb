@@ -255,6 +255,86 @@ def process_logged_events
                 end
             end
 
+            describe "change set" do
+                def change_set
+                    plan_rebuilder.change_set
+                end
+
+                it "records the added objects" do
+                    local_plan.add(Tasks::Simple.new)
+                    process_logged_events
+                    r_task = rebuilt_plan.tasks.first
+                    assert change_set.added_objects.include?(r_task)
+                    assert change_set.added_objects.include?(r_task.start_event)
+                end
+
+                it "records the added and removed relations" do
+                    local_plan.add(parent = Tasks::Simple.new(id: "parent"))
+                    local_plan.add(child = Tasks::Simple.new(id: "child"))
+                    process_logged_events
+                    r_parent = rebuilt_plan.find_tasks.with_arguments(id: "parent").first
+                    r_child  = rebuilt_plan.find_tasks.with_arguments(id: "child").first
+
+                    plan_rebuilder.clear_integrated
+                    parent.depends_on child
+                    process_logged_events
+                    assert_equal Set[[r_parent, r_child, TaskStructure::Dependency]],
+                                 change_set.added_edges
+
+                    plan_rebuilder.clear_integrated
+                    parent.remove_child child
+                    process_logged_events
+                    assert_equal Set[[r_parent, r_child, TaskStructure::Dependency]],
+                                 change_set.removed_edges
+                    assert change_set.added_edges.empty?
+                end
+
+                it "records the tasks whose status changed" do
+                    local_plan.add(task = Tasks::Simple.new)
+                    process_logged_events
+                    r_task = rebuilt_plan.tasks.first
+
+                    plan_rebuilder.clear_integrated
+                    local_plan.add_mission_task(task)
+                    process_logged_events
+                    assert change_set.changed_objects.include?(r_task)
+                end
+
+                it "records the tasks whose events have been emitted" do
+                    local_plan.add(task = Tasks::Simple.new)
+                    process_logged_events
+                    r_task = rebuilt_plan.tasks.first
+
+                    plan_rebuilder.clear_integrated
+                    execute { task.start! }
+                    process_logged_events
+                    assert change_set.changed_objects.include?(r_task)
+                end
+
+                it "records the finalized objects" do
+                    local_plan.add(task = Tasks::Simple.new)
+                    process_logged_events
+                    r_task = rebuilt_plan.tasks.first
+
+                    plan_rebuilder.clear_integrated
+                    execute { local_plan.remove_task(task) }
+                    process_logged_events
+                    assert change_set.removed_objects.include?(r_task)
+                end
+
+                it "resets the change set in #clear_integrated" do
+                    local_plan.add(Tasks::Simple.new)
+                    process_logged_events
+                    plan_rebuilder.clear_integrated
+                    assert change_set.empty?
+                end
+
+                it "marks the change set as full when the rebuilder is cleared" do
+                    plan_rebuilder.clear
+                    assert change_set.full?
+                end
+            end
+
             describe "transaction structure" do
                 it "can duplicate a merged plan" do
                     local_plan.in_transaction do |t|
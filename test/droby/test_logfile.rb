@@ -3,6 +3,9 @@
 require "roby/test/self"
 require "roby/droby/logfile/reader"
 require "roby/droby/logfile/writer"
+require "roby/droby/logfile/server"
+require "roby/droby/logfile/snapshot_builder"
+require "roby/droby/event_logger"
 require "roby/test/droby_log_helpers"
 
 module Roby
@@ -276,6 +279,150 @@ module DRoby
                     end
                 end
             end
+
+            describe Logfile::Server do
+                def blocks(*sizes)
+                    sizes.map { |size| Logfile::Server.block("x" * size) }
+                end
+
+                it "computes the size of the complete blocks" do
+                    data = blocks(10, 20).join
+                    assert_equal data.size,
+                                 Logfile::Server.complete_blocks_size(data + "\x05\x00")
+                    assert_equal data.size,
+                                 Logfile::Server.complete_blocks_size(
+                                     data + Logfile::Server.block("x" * 10)[0, 8]
+                                 )
+                end
+
+                it "splits data in chunks of complete blocks" do
+                    server = Logfile::Server.allocate
+                    size = Logfile::Server::DATA_CHUNK_SIZE / 3
+                    data = blocks(size, size, size, size * 4, size).join
+                    chunks = server.split_in_chunks(data)
+                    assert_equal data, chunks.join
+                    assert_equal 4, chunks.size
+                    chunks.each do |c|
+                        assert_equal c.size, Logfile::Server.complete_blocks_size(c)
+                    end
+                end
+
+                describe "#resync_if_lagging" do
+                    before do
+                        path = File.join(tmpdir, "events.log")
+                        FileUtils.touch path
+                        @server = Logfile::Server.new(path, 0.1, flexmock,
+                                                      max_client_backlog: 100)
+                        builder = flexmock(@server.snapshot_builder)
+                        builder.should_receive(:available?).and_return(true).by_default
+                        builder.should_receive(:snapshot).and_return(:snapshot)
+                        @socket = flexmock
+                        @socket.should_receive(:close).by_default
+                        @init, @init_done = @server.connection_init_data
+                    end
+
+                    after do
+                        @server.close
+                    end
+
+                    def resync_chunks(skipped)
+                        [Logfile::Server.block(
+                            ::Marshal.dump([Logfile::Server::CONNECTION_RESYNC, skipped])
+                        ),
+                         Logfile::Server.block(::Marshal.dump(:snapshot))]
+                    end
+
+                    it "does not modify the chunks of a client within the backlog" do
+                        chunks = [@init, *blocks(10), @init_done]
+                        expected = chunks.dup
+                        @server.resync_if_lagging(@socket, chunks)
+                        assert_equal expected, chunks
+                    end
+
+                    it "replaces the data of a lagging client by a snapshot, "\
+                       "keeping the connection init messages" do
+                        chunks = [@init, *blocks(60, 60), @init_done]
+                        @server.resync_if_lagging(@socket, chunks)
+                        assert_equal [@init, *resync_chunks(128), @init_done], chunks
+                        assert_same @init, chunks.first
+                        assert_same @init_done, chunks.last
+                    end
+
+                    it "keeps the partially sent head chunk" do
+                        head = blocks(50).first
+                        @server.pending_data[@socket] = [head]
+                        @socket.should_receive(:write_nonblock).with(head).once
+                               .and_return(10)
+                        @server.send_pending_data
+
+                        chunks = @server.pending_data[@socket]
+                        chunks.concat(blocks(200))
+                        @server.resync_if_lagging(@socket, chunks)
+                        assert_equal [head[10..-1], *resync_chunks(204)], chunks
+                    end
+
+                    it "does nothing if no snapshot is available yet" do
+                        flexmock(@server.snapshot_builder)
+                            .should_receive(:available?).and_return(false)
+                        chunks = [@init, *blocks(60, 60), @init_done]
+                        expected = chunks.dup
+                        @server.resync_if_lagging(@socket, chunks)
+                        assert_equal expected, chunks
+                    end
+                end
+            end
+
+            describe Logfile::SnapshotBuilder do
+                before do
+                    @logfile = flexmock(flush: nil)
+                    @cycles = []
+                    @logfile.should_receive(:dump).and_return { |c| @cycles << c }
+                    @event_logger = EventLogger.new(@logfile)
+                    @local_plan = ExecutablePlan.new(event_logger: @event_logger)
+                    @builder = Logfile::SnapshotBuilder.new
+                end
+
+                def flush_cycles
+                    now = Time.now
+                    @event_logger.flush_cycle(
+                        :cycle_end, now, [{ start: [now.tv_sec, now.tv_usec] }]
+                    )
+                    @event_logger.flush
+                    cycles = @cycles.dup
+                    @cycles.clear
+                    cycles.each { |c| @builder.process_cycle(c) }
+                    cycles
+                end
+
+                it "is not available until a cycle has been processed" do
+                    refute @builder.available?
+                    flush_cycles
+                    assert @builder.available?
+                end
+
+                it "synthesizes a cycle from which a client can resume the stream" do
+                    parent = Tasks::Simple.new(id: "parent")
+                    child = Tasks::Simple.new(id: "child")
+                    @local_plan.add_mission_task(parent)
+                    parent.depends_on child
+                    flush_cycles
+
+                    client = PlanRebuilder.new
+                    client.process_one_cycle(@builder.snapshot)
+                    plan = client.plan
+                    parent = plan.find_tasks.with_arguments(id: "parent").first
+                    child = plan.find_tasks.with_arguments(id: "child").first
+                    assert plan.mission_task?(parent)
+                    assert parent.depends_on?(child)
+
+                    @local_plan.find_tasks.with_arguments(id: "parent").first
+                               .remove_child(
+                                   @local_plan.find_tasks.with_arguments(id: "child").first
+                               )
+                    flush_cycles.each { |c| client.process_one_cycle(c) }
+                    refute parent.depends_on?(child)
+                end
+            end
         end
     end
 end
@@ -0,0 +1,48 @@
+# frozen_string_literal: true
+
+require "roby/test/self"
+require "roby/droby/plan_change_set"
+
+module Roby
+    module DRoby
+        describe PlanChangeSet do
+            it "is empty when created" do
+                assert PlanChangeSet.new.empty?
+            end
+
+            it "is not empty when full" do
+                change_set = PlanChangeSet.full
+                assert change_set.full?
+                refute change_set.empty?
+            end
+
+            describe "#merge" do
+                it "adds the changes of the other change set" do
+                    a = PlanChangeSet.new
+                    a.added_objects << (task_a = flexmock)
+                    b = PlanChangeSet.new
+                    b.added_objects << (task_b = flexmock)
+                    b.removed_edges << (edge = [task_a, task_b, flexmock])
+                    b.changed_objects << task_b
+
+                    a.merge(b)
+                    assert_equal Set[task_a, task_b], a.added_objects
+                    assert_equal Set[edge], a.removed_edges
+                    assert_equal Set[task_b], a.changed_objects
+                    refute a.full?
+                end
+
+                it "becomes full if the other change set is" do
+                    assert PlanChangeSet.new.merge(PlanChangeSet.full).full?
+                end
+            end
+
+            it "enumerates the added and removed edges" do
+                change_set = PlanChangeSet.new
+                change_set.added_edges << (added = [1, 2, 3])
+                change_set.removed_edges << (removed = [4, 5, 6])
+                assert_equal [added, removed], change_set.each_changed_edge.to_a
+            end
+        end
+    end
+end
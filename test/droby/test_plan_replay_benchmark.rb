@@ -0,0 +1,122 @@
+# frozen_string_literal: true
+
+require "roby/test/self"
+
+require "roby/droby/event_logger"
+require "roby/droby/plan_replay_benchmark"
+
+module Roby
+    module DRoby
+        describe PlanReplayBenchmark do
+            attr_reader :logfile, :local_plan, :benchmark
+
+            before do
+                @logfile = Class.new do
+                    attr_reader :cycles
+
+                    def initialize
+                        @cycles = []
+                    end
+
+                    def flush; end
+
+                    def dump(cycle)
+                        cycles << cycle
+                    end
+                end.new
+                @event_logger = EventLogger.new(logfile)
+                @local_plan = ExecutablePlan.new(event_logger: @event_logger)
+                @benchmark = PlanReplayBenchmark.new
+            end
+
+            def replay_logged_events
+                @event_logger.flush_cycle(:cycle_end, Time.now, [{}])
+                @event_logger.flush
+                logfile.cycles.each { |c| benchmark.process_one_cycle(c) }
+                logfile.cycles.clear
+            end
+
+            def replayed_task(id)
+                benchmark.plan.find_tasks.with_arguments(id: id).first
+            end
+
+            it "replays the plan operations in an executable plan" do
+                parent = Tasks::Simple.new(id: "parent")
+                child = Tasks::Simple.new(id: "child")
+                local_plan.add_mission_task(parent)
+                local_plan.add(child)
+                parent.depends_on child
+                replay_logged_events
+
+                assert_kind_of ExecutablePlan, benchmark.plan
+                parent = replayed_task("parent")
+                child = replayed_task("child")
+                assert benchmark.plan.mission_task?(parent)
+                assert parent.depends_on?(child)
+            end
+
+            it "removes finalized tasks" do
+                local_plan.add(task = Tasks::Simple.new(id: "task"))
+                replay_logged_events
+                local_plan.remove_task(task)
+                replay_logged_events
+
+                assert benchmark.plan.tasks.empty?
+            end
+
+            it "times each operation class" do
+                parent = Tasks::Simple.new(id: "parent")
+                child = Tasks::Simple.new(id: "child")
+                local_plan.add(parent)
+                local_plan.add(child)
+                parent.depends_on child
+                parent.remove_child child
+                replay_logged_events
+
+                timings = benchmark.timings
+                assert_equal 2, timings[:merged_plan].count
+                assert_equal 1, timings[:added_edge].count
+                assert_equal 1, timings[:removed_edge].count
+                assert_equal 0, timings[:added_edge].errors
+                assert_operator timings[:merged_plan].total, :>=, 0
+            end
+
+            it "replays the relation changes logged as a group" do
+                local_plan.add(parent = Tasks::Simple.new(id: "parent"))
+                local_plan.add(replaced = Tasks::Simple.new(id: "replaced"))
+                local_plan.add(replacing = Tasks::Simple.new(id: "replacing"))
+                parent.depends_on replaced
+                replay_logged_events
+
+                local_plan.replace_tasks(replaced => replacing)
+                messages = @event_logger.current_cycle.each_slice(4).map(&:first)
+                assert_equal [:grouped_edge_changes], messages.grep(/edge/)
+                replay_logged_events
+
+                parent = replayed_task("parent")
+                assert parent.depends_on?(replayed_task("replacing"))
+                refute parent.depends_on?(replayed_task("replaced"))
+                assert_equal 1, benchmark.timings[:removed_edge].count
+            end
+
+            it "counts the operations that raise" do
+                flexmock(benchmark.plan).should_receive(:add_mission_task)
+                                        .and_raise(ArgumentError)
+                local_plan.add_mission_task(Tasks::Simple.new)
+                replay_logged_events
+
+                assert_equal 1, benchmark.timings[:task_status_change].count
+                assert_equal 1, benchmark.timings[:task_status_change].errors
+            end
+
+            it "updates the task state from the emitted events" do
+                local_plan.add(task = Tasks::Simple.new(id: "task"))
+                execute(plan: local_plan) { task.start! }
+                replay_logged_events
+
+                assert replayed_task("task").running?
+                assert_equal 1, benchmark.timings[:generator_fired].count
+            end
+        end
+    end
+end
@@ -429,6 +429,72 @@ def test_temporal_constraint_when_source_did_not_emit_yet
                         assert receiver.should_emit_after?(argument)
                     end
                 end
+
+                describe ".count_emissions_until" do
+                    attr_reader :generator, :base_time
+                    before do
+                        plan.add(@generator = EventGenerator.new)
+                        @base_time = Time.now
+                        (0...5).each do |i|
+                            generator.history <<
+                                Event.new(generator, i, [], base_time + i)
+                        end
+                    end
+
+                    it "returns the number of emissions at or before the given time" do
+                        assert_equal 3, TemporalConstraints.count_emissions_until(
+                            generator.history, base_time + 2
+                        )
+                    end
+                    it "returns zero if all emissions are after the given time" do
+                        assert_equal 0, TemporalConstraints.count_emissions_until(
+                            generator.history, base_time - 1
+                        )
+                    end
+                    it "returns the history size if all emissions are before the given time" do
+                        assert_equal 5, TemporalConstraints.count_emissions_until(
+                            generator.history, base_time + 10
+                        )
+                    end
+                end
+
+                describe "#find_failed_temporal_constraint" do
+                    attr_reader :parent, :child, :base_time
+                    before do
+                        plan.add(@parent = EventGenerator.new)
+                        plan.add(@child = EventGenerator.new)
+                        @base_time = Time.now
+                        [0, 5, 10].each do |i|
+                            parent.history << Event.new(parent, i, [], base_time + i)
+                        end
+                    end
+
+                    it "passes if all parent emissions are within the interval" do
+                        parent.add_temporal_constraint(child, 2, 15)
+                        refute child.find_failed_temporal_constraint(base_time + 12)
+                    end
+                    it "fails if the oldest parent emission is too old" do
+                        parent.add_temporal_constraint(child, 2, 15)
+                        assert_equal parent, child.find_failed_temporal_constraint(
+                            base_time + 16
+                        ).first
+                    end
+                    it "fails if the newest parent emission is too recent" do
+                        parent.add_temporal_constraint(child, 2, 15)
+                        assert_equal parent, child.find_failed_temporal_constraint(
+                            base_time + 11
+                        ).first
+                    end
+                    it "checks each parent emission against disjoint intervals" do
+                        parent.add_temporal_constraint(child, 0, 3)
+                        parent.add_temporal_constraint(child, 6, 8)
+                        parent.add_temporal_constraint(child, 11, 20)
+                        refute child.find_failed_temporal_constraint(base_time + 12)
+                        assert_equal parent, child.find_failed_temporal_constraint(
+                            base_time + 14
+                        ).first
+                    end
+                end
             end
         end
     end
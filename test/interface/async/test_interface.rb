@@ -378,6 +378,96 @@ def interface
                     end
                 end
 
+                describe "#dispatch_new_job" do
+                    attr_reader :interface, :remote_client
+
+                    before do
+                        @interface = Interface.new(connect: false)
+                        @remote_client = flexmock
+                        flexmock(interface).should_receive(:client).and_return(remote_client)
+                    end
+
+                    def job_task(action_name)
+                        flexmock(action_model: flexmock(name: action_name))
+                    end
+
+                    it "only calls the listeners of the job's action" do
+                        task = job_task("a")
+                        remote_client.should_receive(:find_job_info_by_id)
+                            .with(1).and_return([JOB_READY, task, task])
+                        interface.on_job(action_name: "a", jobs: []) { |j| recorder.a(j.job_id) }
+                        interface.on_job(action_name: "b", jobs: []) { |j| recorder.b(j.job_id) }
+                        interface.on_job(jobs: []) { |j| recorder.all(j.job_id) }
+                        recorder.should_receive(:a).with(1).once.ordered
+                        recorder.should_receive(:all).with(1).once.ordered
+                        recorder.should_receive(:b).never
+                        interface.dispatch_new_job(JOB_READY, 1, [])
+                    end
+
+                    it "queries the job information once for all the listeners" do
+                        task = job_task("a")
+                        remote_client.should_receive(:find_job_info_by_id)
+                            .with(1).once.and_return([JOB_READY, task, task])
+                        jobs = []
+                        3.times { interface.on_job(jobs: []) { |j| jobs << j } }
+                        cache = {}
+                        interface.dispatch_new_job(JOB_READY, 1, [], cache)
+                        interface.dispatch_new_job(JOB_STARTED, 1, [], cache)
+                        assert_equal 3, jobs.map(&:object_id).uniq.size
+                    end
+
+                    it "does not query the job information if all listeners saw the job" do
+                        remote_client.should_receive(:find_job_info_by_id).never
+                        listener = interface.on_job(jobs: []) {}
+                        listener.ignored(flexmock(job_id: 1))
+                        interface.dispatch_new_job(JOB_READY, 1, [])
+                    end
+
+                    it "queries a job of another action only once across polls" do
+                        task = job_task("b")
+                        remote_client.should_receive(:find_job_info_by_id)
+                            .with(1).once.and_return([JOB_READY, task, task])
+                        interface.on_job(action_name: "a", jobs: []) { recorder.called }
+                        recorder.should_receive(:called).never
+                        queue_and_poll([JOB_READY, 1, "job"])
+                        queue_and_poll([JOB_STARTED, 1, "job"])
+                    end
+
+                    it "queries a job again once it got finalized" do
+                        task = job_task("b")
+                        remote_client.should_receive(:find_job_info_by_id)
+                            .with(1).twice.and_return([JOB_READY, task, task])
+                        interface.on_job(action_name: "a", jobs: []) {}
+                        queue_and_poll([JOB_READY, 1, "job"], [JOB_FINALIZED, 1, "job"])
+                        queue_and_poll([JOB_READY, 1, "job"])
+                    end
+
+                    def queue_and_poll(*progress)
+                        unless @progress_queue
+                            @progress_queue = []
+                            remote_client.should_receive(
+                                notification_queue: [], ui_event_queue: [],
+                                exception_queue: [], job_progress_queue: @progress_queue
+                            )
+                        end
+                        @progress_queue.concat(progress.map { |msg| [0, msg] })
+                        interface.process_message_queues
+                    end
+
+                    it "stops dispatching to removed listeners" do
+                        task = job_task("a")
+                        remote_client.should_receive(:find_job_info_by_id)
+                            .and_return([JOB_READY, task, task])
+                        listener = interface.on_job(action_name: "a", jobs: []) do
+                            recorder.called
+                        end
+                        listener.stop
+                        recorder.should_receive(:called).never
+                        interface.dispatch_new_job(JOB_READY, 1, [])
+                        assert interface.new_job_listeners.empty?
+                    end
+                end
+
                 describe "notifications" do
                     attr_reader :client, :server
                     before do
@@ -51,6 +51,33 @@ module Interface
                 channel.push_write_data
                 assert_equal("1" * io_w_buffer_size, @io_r.read(io_w_buffer_size))
             end
+            it "sends queued data in order" do
+                channel = DRobyChannel.new(@io_w, false)
+                io_w_buffer_size = @io_w.getsockopt(Socket::SOL_SOCKET, Socket::SO_RCVBUF).int
+                @io_w.write("0" * io_w_buffer_size)
+                chunks = (1..100).map { |i| i.to_s * i }
+                chunks.each { |c| channel.push_write_data(c) }
+                assert_equal chunks.join.size, channel.write_buffer_size
+
+                @io_r.read(io_w_buffer_size)
+                refute channel.push_write_data
+                assert_equal 0, channel.write_buffer_size
+                assert_equal chunks.join, @io_r.read(chunks.join.size)
+            end
+            it "gathers queued chunks and resumes partial writes within a chunk" do
+                channel = DRobyChannel.new(@io_w, false)
+                written = []
+                flexmock(@io_w).should_receive(:syswrite)
+                               .and_return do |data|
+                                   written << data.byteslice(0, 3)
+                                   written.last.bytesize
+                               end
+
+                assert channel.push_write_data("abcd")
+                %w[ef ghi jk].each { |c| channel.push_write_data(c) }
+                assert_equal %w[abc def ghi jk], written
+                assert_equal 0, channel.write_buffer_size
+            end
             it "raises ComError if the internal write buffer reaches its maximum size" do
                 channel = DRobyChannel.new(@io_w, false, max_write_buffer_size: 1024)
                 io_w_buffer_size = @io_w.getsockopt(Socket::SOL_SOCKET, Socket::SO_RCVBUF).int
@@ -729,4 +729,29 @@ def other_planning_method
             assert_equal result, interface.log_dir
         end
     end
+
+    describe "#reset" do
+        it "resets the app for reuse" do
+            flexmock(interface.app).should_receive(:reset_for_reuse)
+                                   .with(log_dir: "/path", controller: false).once
+            interface.reset(log_dir: "/path", controller: false)
+        end
+        it "reports that the reset is in progress until the app finished it" do
+            app.log_base_dir = make_tmpdir
+            interface.reset
+            refute interface.reset_finished?
+            while app.resetting_for_reuse?
+                app.execution_engine.process_events
+                app.execution_engine.cycle_end({})
+            end
+            assert interface.reset_finished?
+        end
+    end
+
+    describe "#save_plan_checkpoint" do
+        it "saves a checkpoint of the app's plan" do
+            flexmock(interface.app).should_receive(:save_plan_checkpoint).once
+            interface.save_plan_checkpoint
+        end
+    end
 end
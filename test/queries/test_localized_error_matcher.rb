@@ -60,4 +60,47 @@
             assert !matcher.failure_point_matcher.generalized?
         end
     end
+
+    describe "#may_match?" do
+        before do
+            @task_m = Roby::Task.new_submodel
+            @error_m = Class.new(Roby::LocalizedError)
+        end
+
+        it "returns false if the exception class is not a subclass of the model" do
+            refute @error_m.match.may_match?(Roby::LocalizedError, @task_m)
+        end
+        it "returns true if the exception class is a subclass of the model" do
+            assert Roby::LocalizedError.match.may_match?(@error_m, @task_m)
+        end
+        it "returns true if the model is not a class" do
+            matcher = Roby::LocalizedError.match.with_model(flexmock)
+            assert matcher.may_match?(@error_m, @task_m)
+        end
+        it "returns true if the model is a module the exception class does not include" do
+            error_tag = Module.new
+            matcher = Roby::LocalizedError.match.with_model(error_tag)
+            assert matcher.may_match?(@error_m, @task_m)
+
+            error = @error_m.new(@task_m.new)
+            error.extend error_tag
+            assert matcher === error
+        end
+        it "returns false if the origin model does not fullfill the task matcher's" do
+            matcher = Roby::LocalizedError.match.with_origin(@task_m)
+            refute matcher.may_match?(@error_m, Roby::Task)
+        end
+        it "returns false if a task origin is expected but the error has none" do
+            matcher = Roby::LocalizedError.match.with_origin(@task_m)
+            refute matcher.may_match?(@error_m, nil)
+        end
+        it "returns true if the origin model fullfills the task matcher's" do
+            matcher = Roby::LocalizedError.match.with_origin(@task_m)
+            assert matcher.may_match?(@error_m, @task_m.new_submodel)
+        end
+        it "ignores event generator origins" do
+            matcher = Roby::LocalizedError.match.with_origin(@task_m.success_event)
+            assert matcher.may_match?(@error_m, nil)
+        end
+    end
 end
@@ -164,4 +164,43 @@ def test_parent_waiting_for_child
         assert !scheduler.can_schedule?(t0, Time.now)
         assert scheduler.can_schedule?(t1, Time.now)
     end
+
+    def test_schedule_as_cycle
+        t0, t1 = prepare_plan add: 2, model: Tasks::Simple
+        t0.schedule_as(t1)
+        t1.schedule_as(t0)
+
+        assert scheduler.can_schedule?(t0, Time.now)
+        assert scheduler.can_schedule?(t1, Time.now)
+    end
+
+    def test_shared_schedule_as_parent_is_evaluated_once_per_pass
+        parent, *children = prepare_plan add: 4, model: Tasks::Simple
+        parent.executable = false
+        children.each { |t| t.schedule_as(parent) }
+
+        flexmock(parent.start_event)
+            .should_receive(:find_failed_temporal_constraint).once.pass_thru
+        execute { scheduler.initial_events }
+        assert children.all?(&:running?)
+    end
+
+    def test_decisions_depend_on_the_stack
+        t0, t1, t2 = prepare_plan add: 3, model: Tasks::Simple
+        t0.schedule_as(t1)
+        t1.schedule_as(t2)
+        t2.should_start_after(t0)
+
+        now = Time.now
+        result = scheduler.with_scheduling_decisions do
+            [scheduler.can_schedule?(t2, now), scheduler.can_schedule?(t0, now),
+             scheduler.can_schedule?(t2, now)]
+        end
+        assert_equal [false, true, false], result
+
+        result = scheduler.with_scheduling_decisions do
+            [scheduler.can_schedule?(t0, now), scheduler.can_schedule?(t2, now)]
+        end
+        assert_equal [true, false], result
+    end
 end
@@ -512,4 +512,56 @@ def test_it_raises_if_trying_to_access_a_non_method
             s.send("not:a:method")
         end
     end
+
+    def test_it_defines_accessors_for_the_fields_that_are_set
+        s = Roby::OpenStruct.new
+        s.value = 42
+        s.child.value = 10
+        assert_equal %i[child child= value value=].to_set,
+                     s.singleton_methods.to_set
+        s.value = 24
+        assert_equal 24, s.value
+        assert_equal 10, s.child.value
+    end
+
+    def test_generated_writers_go_through_filters_and_observers
+        s = Roby::OpenStruct.new
+        s.value = 0
+        s.filter(:value) { |v| v * 2 }
+        values = []
+        s.on_change(:value) { |_, v| values << v }
+        s.value = 21
+        assert_equal 42, s.value
+        assert_equal [42], values
+    end
+
+    def test_generated_accessors_fall_back_to_the_dynamic_behaviour_once_deleted
+        s = Roby::OpenStruct.new
+        s.value = 42
+        s.delete(:value)
+        assert !s.respond_to?(:value)
+        assert_kind_of Roby::OpenStruct, s.value
+        assert !s.value.attached?
+    end
+
+    def test_generated_writers_are_disabled_on_stable_structs
+        s = Roby::OpenStruct.new
+        s.value = 42
+        s.stable!
+        assert !s.respond_to?(:value=)
+        assert_raises(NoMethodError) { s.value = 10 }
+        assert_equal 42, s.value
+    end
+
+    def test_it_defines_accessors_for_the_fields_declared_in_the_model
+        s = Roby::OpenStruct.new
+        m = s.new_model
+        m.pose.position = OpenStructModel::Variable.new
+        assert s.singleton_methods.include?(:pose)
+        assert s.pose.singleton_methods.include?(:position)
+        assert !s.pose.respond_to?(:position)
+        assert_nil s.pose.position
+        s.pose.position = 42
+        assert_equal 42, s.pose.position
+    end
 end
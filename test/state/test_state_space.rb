@@ -99,6 +99,19 @@ def test_field_cannot_be_assigned_if_a_data_source_is_specified
         assert_raises(ArgumentError) { s.pose.position = Object.new }
     end
 
+    def test_field_with_an_accessor_cannot_be_assigned_if_a_data_source_is_specified
+        s = create_state_space("pose.position")
+        s.pose.position = Object.new
+        s.pose.data_sources.position = Object.new
+        assert_raises(ArgumentError) { s.pose.position = Object.new }
+    end
+
+    def test_last_known_values_cannot_be_assigned_through_their_accessors
+        s = create_state_space("pose.position")
+        s.last_known.set(:pose, 10)
+        assert_raises(ArgumentError) { s.last_known.pose = 20 }
+    end
+
     def test_field_returns_nil_if_a_type_is_specified_and_no_value_exists
         s = create_state_space("pose.position")
         s.pose.model.position = Position
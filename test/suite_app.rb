@@ -5,5 +5,6 @@
 require "./test/app/test_robot_names"
 require "./test/app/test_init"
 require "./test/app/test_run"
+require "./test/app/test_test_impact"
 
 require "./test/cli/test_display"
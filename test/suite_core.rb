@@ -42,6 +42,9 @@
 
 require "./test/test_execution_engine"
 require "./test/test_execution_exception"
+require "./test/test_poll_scheduler"
+require "./test/test_async_logger"
+require "./test/test_plan_checkpoint"
 
 require "./test/test_plan"
 require "./test/test_executable_plan"
@@ -52,6 +55,7 @@
 require "./test/tasks/test_virtual"
 require "./test/tasks/test_thread_task"
 require "./test/tasks/test_external_process"
+require "./test/tasks/test_remote_job"
 
 require "./test/schedulers/test_state"
 require "./test/schedulers/test_basic"
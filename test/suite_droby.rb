@@ -5,6 +5,8 @@
 require "./test/droby/test_logfile"
 require "./test/droby/test_marshal"
 require "./test/droby/test_object_manager"
+require "./test/droby/test_plan_change_set"
+require "./test/droby/test_plan_replay_benchmark"
 
 require "./test/droby/v5/test_builtin"
 require "./test/droby/v5/test_droby_constant"
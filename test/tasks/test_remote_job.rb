@@ -0,0 +1,127 @@
+# frozen_string_literal: true
+
+require "roby/test/self"
+require "roby/tasks/remote_job"
+
+module Roby
+    module Tasks
+        describe RemoteJob do
+            before do
+                @client = flexmock
+                @client.should_receive(closed?: false, close: nil, poll: nil,
+                                       io: flexmock(reset_thread_guard: nil))
+                       .by_default
+                @client.should_receive(:async_call).by_default
+                @job_progress = []
+                @client.should_receive(:pop_job_progress)
+                       .and_return { @job_progress.shift }
+                @client.should_receive(:start_job)
+                       .with("goto", x: 10).and_return(42).by_default
+                plan.add(@task = RemoteJob.new(action_name: "goto",
+                                               action_arguments: { x: 10 }))
+                flexmock(@task).should_receive(:connect).and_return(@client).by_default
+            end
+
+            after do
+                if @task.running?
+                    execute { @task.stop! } unless @task.stop_event.pending?
+                    push_job_progress(Interface::JOB_FINISHED)
+                    expect_execution.to { emit @task.stop_event }
+                end
+            end
+
+            def push_job_progress(state, job_id = 42)
+                @job_progress << [@job_progress.size, [state, job_id, "goto"]]
+            end
+
+            it "starts the action as a job on the remote instance" do
+                expect_execution { @task.start! }.to { emit @task.start_event }
+                assert_equal 42, @task.remote_job_id
+            end
+
+            it "fails to start if the job cannot be started" do
+                @client.should_receive(:start_job)
+                       .and_raise(Interface::Client::NoSuchAction)
+                @client.should_receive(:close).once
+                expect_execution { @task.start! }
+                    .to { fail_to_start @task }
+            end
+
+            it "fails to start if the remote instance cannot be reached" do
+                flexmock(@task).should_receive(:connect)
+                               .and_raise(Interface::ConnectionError)
+                expect_execution { @task.start! }
+                    .to { fail_to_start @task }
+                assert_nil @task.client
+            end
+
+            describe "running" do
+                before do
+                    expect_execution { @task.start! }.to { emit @task.start_event }
+                end
+
+                it "emits remote_started when the remote job is started" do
+                    push_job_progress(Interface::JOB_STARTED)
+                    expect_execution.to { emit @task.remote_started_event }
+                    assert_equal Interface::JOB_STARTED, @task.remote_job_state
+                end
+
+                it "ignores the notifications of other jobs" do
+                    push_job_progress(Interface::JOB_SUCCESS, 10)
+                    expect_execution.to { not_emit @task.stop_event }
+                end
+
+                it "emits success when the remote job succeeds" do
+                    push_job_progress(Interface::JOB_SUCCESS)
+                    push_job_progress(Interface::JOB_FINALIZED)
+                    expect_execution.to { emit @task.success_event }
+                end
+
+                it "emits failed when the remote job fails" do
+                    push_job_progress(Interface::JOB_FAILED)
+                    expect_execution.to { emit @task.failed_event }
+                end
+
+                it "emits lost if the remote job is dropped" do
+                    push_job_progress(Interface::JOB_DROPPED)
+                    expect_execution.to do
+                        emit @task.lost_event
+                        emit @task.failed_event
+                    end
+                end
+
+                it "emits lost if the communication breaks" do
+                    @client.should_receive(:poll).and_raise(Interface::ComError)
+                    expect_execution.to { emit @task.lost_event }
+                end
+
+                it "kills the remote job on stop, and emits stop when it is finished" do
+                    @client.should_receive(:async_call).with([], :kill_job, 42).once
+                    expect_execution { @task.stop! }.to { not_emit @task.stop_event }
+                    push_job_progress(Interface::JOB_FINISHED)
+                    expect_execution.to { emit @task.stop_event }
+                    refute @task.failed?
+                end
+
+                it "emits lost if the kill request cannot be sent" do
+                    @client.should_receive(:async_call).and_raise(Interface::ComError)
+                    expect_execution { @task.stop! }.to { emit @task.lost_event }
+                end
+
+                it "emits lost if the remote instance refuses the kill request" do
+                    @client.should_receive(:async_call)
+                           .and_return { |*_, &block| @kill_reply = block }
+                    execute { @task.stop! }
+                    expect_execution { @kill_reply.call(ArgumentError.new("no job"), nil) }
+                        .to { emit @task.lost_event }
+                end
+
+                it "closes the connection once stopped" do
+                    @client.should_receive(:close).once
+                    push_job_progress(Interface::JOB_SUCCESS)
+                    expect_execution.to { emit @task.stop_event }
+                end
+            end
+        end
+    end
+end
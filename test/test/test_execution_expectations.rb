@@ -222,6 +222,60 @@ def at_cycle_end
                         end
                     end
                 end
+                describe "incremental matching" do
+                    it "passes to the expectations only what happened since "\
+                       "the last update" do
+                        plan.add(generator = EventGenerator.new)
+                        deltas = []
+                        expectation_m = Class.new(ExecutionExpectations::Expectation) do
+                            define_method(:update_match_incremental) do |_, delta|
+                                deltas << delta.emitted_events.map(&:generator)
+                                deltas.size > 3
+                            end
+                        end
+                        expect_execution
+                            .poll { generator.emit if deltas.size == 1 }
+                            .to { add_expectation(expectation_m.new([])) }
+                        assert_equal [[], [generator], [], []], deltas[0, 4]
+                    end
+
+                    it "falls back to #update_match with the accumulated "\
+                       "propagation info" do
+                        plan.add(generator = EventGenerator.new)
+                        emitted = []
+                        expectation = flexmock(unachievable?: false)
+                        expectation.should_receive(:update_match)
+                                   .and_return do |info|
+                                       emitted << info.emitted_events.size
+                                       emitted.size > 2
+                                   end
+                        expect_execution { generator.emit }
+                            .to { add_expectation(expectation) }
+                        assert_equal [1, 1, 1], emitted[0, 3]
+                    end
+
+                    it "matches events emitted in an earlier cycle" do
+                        plan.add(generator = EventGenerator.new)
+                        cycles = 0
+                        _, event = expect_execution { generator.emit }
+                                   .poll { cycles += 1 }
+                                   .to { [achieve { cycles > 3 }, emit(generator)] }
+                        assert_equal generator, event.generator
+                    end
+
+                    it "detects an emission in a later cycle" do
+                        plan.add(generator = EventGenerator.new)
+                        cycles = 0
+                        e = assert_raises(ExecutionExpectations::Unmet) do
+                            expect_execution
+                                .poll { generator.emit if (cycles += 1) == 3 }
+                                .to { not_emit generator }
+                        end
+                        assert_equal 3, cycles
+                        assert_match(/#{Regexp.quote(generator.to_s)} should not be emitted, but/,
+                                     e.message)
+                    end
+                end
             end
 
             describe "standard expectations" do
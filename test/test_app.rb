@@ -149,6 +149,145 @@ def assert_equal(expected, actual)
                 end
             end
 
+            describe "#rewind_log_dir" do
+                before do
+                    app.log_base_dir = File.join(make_tmpdir, "log", "path")
+                    app.find_and_create_log_dir("tag")
+                end
+
+                it "creates a new log directory" do
+                    old_dir = app.log_dir
+                    new_dir = app.rewind_log_dir
+                    refute_equal old_dir, new_dir
+                    assert_equal new_dir, app.log_dir
+                    assert File.directory?(new_dir)
+                end
+                it "switches to an explicitly given directory" do
+                    dir = make_tmpdir
+                    assert_equal dir, app.rewind_log_dir(dir)
+                    assert_equal dir, app.log_dir
+                    assert File.file?(File.join(dir, "info.yml"))
+                end
+            end
+
+            describe "plan checkpoints" do
+                before do
+                    app.log_base_dir = make_tmpdir
+                end
+
+                it "saves the checkpoint in the log base directory by default" do
+                    app.save_plan_checkpoint
+                    assert File.file?(File.join(app.log_base_dir, "plan-checkpoint"))
+                end
+
+                it "restores a saved checkpoint" do
+                    app.plan.add_mission_task(task = Roby::Tasks::Simple.new)
+                    app.save_plan_checkpoint
+                    restored = app.restore_plan_checkpoint
+                    assert_equal 1, restored.size
+                    assert app.plan.mission_task?(restored.first)
+                    refute_same task, restored.first
+                end
+
+                it "reserves the job IDs of the restored jobs" do
+                    job_m = Roby::Tasks::Simple.new_submodel do
+                        provides Roby::Interface::Job
+                    end
+                    flexmock(Roby::PlanCheckpoint)
+                        .new_instances.should_receive(:restore)
+                        .and_return([job_m.new(job_id: 1_000_000)])
+                    app.save_plan_checkpoint
+                    app.restore_plan_checkpoint
+                    assert Roby::Interface::Job.allocate_job_id > 1_000_000
+                end
+
+                it "returns nil if there is no checkpoint" do
+                    assert_nil app.restore_plan_checkpoint
+                end
+
+                it "returns nil if the checkpoint cannot be restored" do
+                    File.write(File.join(app.log_base_dir, "plan-checkpoint"), "")
+                    assert_nil app.restore_plan_checkpoint
+                end
+            end
+
+            describe "#reset_for_reuse" do
+                attr_reader :engine
+
+                before do
+                    app.log_base_dir = File.join(make_tmpdir, "log", "path")
+                    app.find_and_create_log_dir("tag")
+                    @engine = app.execution_engine
+                end
+
+                after do
+                    Roby::State.delete(:reset_for_reuse_test) if Roby::State.reset_for_reuse_test?
+                    if Roby::State.reset_for_reuse_struct?
+                        Roby::State.delete(:reset_for_reuse_struct)
+                    end
+                end
+
+                def process_reset
+                    while app.resetting_for_reuse?
+                        engine.process_events
+                        engine.cycle_end({})
+                    end
+                end
+
+                it "clears the plan and switches to a new log directory" do
+                    app.plan.add_permanent_task(task = Roby::Task.new)
+                    old_dir = app.log_dir
+                    app.reset_for_reuse
+                    assert app.resetting_for_reuse?
+                    process_reset
+                    assert task.finalized?
+                    refute_equal old_dir, app.log_dir
+                end
+                it "removes the state members created after the app was prepared" do
+                    app.prepare
+                    Roby::State.reset_for_reuse_test = 10
+                    app.reset_for_reuse
+                    process_reset
+                    refute Roby::State.reset_for_reuse_test?
+                ensure
+                    app.shutdown
+                end
+                it "restores the value of the state members that existed when the app was prepared" do
+                    Roby::State.reset_for_reuse_test = 10
+                    Roby::State.reset_for_reuse_struct.value = 20
+                    app.prepare
+                    Roby::State.reset_for_reuse_test = 30
+                    Roby::State.reset_for_reuse_struct.value = 40
+                    Roby::State.reset_for_reuse_struct.other = 50
+                    app.reset_for_reuse
+                    process_reset
+                    assert_equal 10, Roby::State.reset_for_reuse_test
+                    assert_equal 20, Roby::State.reset_for_reuse_struct.value
+                    refute Roby::State.reset_for_reuse_struct.other?
+                ensure
+                    app.shutdown
+                end
+                it "runs the controller blocks again" do
+                    recorder = flexmock
+                    recorder.should_receive(:called).once
+                    app.controller { recorder.called }
+                    app.reset_for_reuse
+                    process_reset
+                end
+                it "does not run the controller blocks if controller is false" do
+                    recorder = flexmock
+                    recorder.should_receive(:called).never
+                    app.controller { recorder.called }
+                    app.reset_for_reuse(controller: false)
+                    process_reset
+                end
+                it "raises if a reset is already in progress" do
+                    app.reset_for_reuse
+                    assert_raises(ArgumentError) { app.reset_for_reuse }
+                    process_reset
+                end
+            end
+
             describe "#test_files_for" do
                 attr_reader :base_dir
 
@@ -204,6 +343,28 @@ def create_file(*path)
                 end
             end
 
+            describe "#definition_files_for" do
+                attr_reader :base_dir
+
+                before do
+                    @base_dir = make_tmpdir
+                    app.search_path = [base_dir]
+                end
+
+                it "returns the model files involved in the definition" do
+                    model_path = File.join(base_dir, "models", "compositions", "file.rb")
+                    m = flexmock(definition_location: [
+                                     flexmock(absolute_path: model_path, lineno: 120, label: "m"),
+                                     flexmock(absolute_path: File.join(base_dir, "scripts", "load.rb"), lineno: 10, label: "m"),
+                                     flexmock(absolute_path: model_path, lineno: 10, label: "m")
+                                 ])
+                    assert_equal [model_path], app.definition_files_for(m)
+                end
+                it "returns an empty array for models without definition location" do
+                    assert_equal [], app.definition_files_for(flexmock(definition_location: nil))
+                end
+            end
+
             describe "#find_base_path_for" do
                 before do
                     app.search_path = %w{/bla/blo /bla/blo/blu}
@@ -852,6 +1013,18 @@ def self.setup_rest_interface(app, api)
                     @app.load_base_config
                     assert_equal Logger::DEBUG, Roby::LoggerSetupTests.logger.level
                 end
+                it "creates async loggers if async text logs are enabled" do
+                    @app.log_setup "roby/logger_setup_tests", "DEBUG"
+                    @app.async_text_logs = true
+                    @app.async_text_logs_overflow = "block"
+                    @app.load_base_config
+                    logger = Roby::LoggerSetupTests.logger
+                    assert_kind_of AsyncLogger, logger
+                    assert_equal :block, logger.overflow
+                    assert_equal Logger::DEBUG, logger.level
+                ensure
+                    logger&.stop
+                end
                 it "ignores absent contexts" do
                     @app.log_setup "roby/does_not_exist", "DEBUG"
                     @app.load_base_config
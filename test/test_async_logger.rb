@@ -0,0 +1,120 @@
+# frozen_string_literal: true
+
+require "roby/test/self"
+
+module Roby
+    describe AsyncLogger do
+        before do
+            @io = StringIO.new
+        end
+
+        after do
+            @logger&.stop
+        end
+
+        def create_logger(**options)
+            @logger = AsyncLogger.new(@io, **options)
+            @logger.formatter = ->(severity, _, progname, msg) { "#{severity} #{progname} #{msg}\n" }
+            @logger
+        end
+
+        def lazy_message(&block)
+            message = Object.new
+            message.define_singleton_method(:to_s, &block)
+            message
+        end
+
+        it "converts the messages into strings in the writer thread" do
+            logger = create_logger
+            writer_thread = nil
+            logger.info(lazy_message { writer_thread = Thread.current; "msg" })
+            logger.flush
+            assert_equal "INFO  msg\n", @io.string
+            refute_same Thread.current, writer_thread
+        end
+
+        it "evaluates the message block in the calling thread" do
+            logger = create_logger
+            block_thread = nil
+            logger.info { block_thread = Thread.current; "msg" }
+            logger.flush
+            assert_equal "INFO  msg\n", @io.string
+            assert_same Thread.current, block_thread
+        end
+
+        it "does not evaluate the message block below the log level" do
+            logger = create_logger
+            logger.level = Logger::INFO
+            logger.debug { flunk("block evaluated") }
+            logger.flush
+            assert_equal "", @io.string
+        end
+
+        it "passes the progname" do
+            logger = create_logger
+            logger.progname = "test"
+            logger.warn "msg"
+            logger.flush
+            assert_equal "WARN test msg\n", @io.string
+        end
+
+        it "keeps the messages in order" do
+            logger = create_logger(overflow: :block, capacity: 2)
+            100.times { |i| logger.info(i) }
+            logger.flush
+            assert_equal (0...100).map { |i| "INFO  #{i}\n" }.join, @io.string
+        end
+
+        it "drops and reports the messages logged while the queue is full" do
+            logger = create_logger(overflow: :drop, capacity: 1)
+            writing = Queue.new
+            lock = Mutex.new
+            lock.lock
+            logger.info(lazy_message { writing.push(true); lock.synchronize { "blocking" } })
+            writing.pop
+            logger.info("queued")
+            3.times { logger.info("dropped") }
+            lock.unlock
+            logger.flush
+
+            assert_equal 3, logger.dropped_count
+            assert_equal "INFO  blocking\nINFO  queued\n"\
+                         "WARN  3 log messages dropped because the queue was full\n",
+                         @io.string
+        end
+
+        it "raises ArgumentError for an invalid overflow policy" do
+            assert_raises(ArgumentError) { AsyncLogger.new(@io, overflow: :wait) }
+        end
+
+        it "writes the pending messages when stopped" do
+            logger = create_logger
+            logger.info "msg"
+            logger.stop
+            assert_equal "INFO  msg\n", @io.string
+            refute @io.closed?
+        end
+
+        it "writes synchronously after being stopped" do
+            logger = create_logger
+            logger.stop
+            logger.info "msg"
+            assert_equal "INFO  msg\n", @io.string
+        end
+
+        it "closes the device on close" do
+            logger = create_logger
+            logger.info "msg"
+            logger.close
+            assert @io.closed?
+        end
+
+        it "stops all the running loggers in stop_all" do
+            logger = create_logger
+            logger.info "msg"
+            AsyncLogger.stop_all
+            refute logger.open?
+            assert_equal "INFO  msg\n", @io.string
+        end
+    end
+end
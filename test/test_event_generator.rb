@@ -19,6 +19,12 @@ def test_controlable_events
         end
     end
 
+    def test_default_command_is_resolved_on_access
+        event = EventGenerator.new(true)
+        assert event.controlable?
+        assert_equal event.method(:default_command), event.command
+    end
+
     def test_contingent_events
         # Check emission behavior for non-controlable events
         FlexMock.use do |mock|
@@ -601,6 +607,68 @@ def test_plain_all_and_root_sources
         assert_equal [root.last, i1.last, i2.last].to_set, event.all_sources.to_set
         assert_equal [root.last].to_set, event.root_sources.to_set
     end
+
+    def test_sources_are_forgotten_after_the_provenance_retention
+        execution_engine.provenance_retention = 2
+        plan.add(source = Roby::EventGenerator.new(true))
+        plan.add(target = Roby::EventGenerator.new(true))
+        source.forward_to target
+
+        execute { source.call }
+        event = target.last
+        execute_one_cycle
+        assert_equal [source.last].to_set, event.sources
+        execute_one_cycle
+        assert_equal Set.new, event.sources
+    end
+
+    def test_protected_sources_are_kept_beyond_the_provenance_retention
+        execution_engine.provenance_retention = 1
+        plan.add(root = Roby::EventGenerator.new(true))
+        plan.add(source = Roby::EventGenerator.new)
+        plan.add(target = Roby::EventGenerator.new)
+        root.forward_to source
+        source.forward_to target
+
+        execute { root.call }
+        event = target.last
+        event.protect_all_sources
+        execute_one_cycle
+        assert_equal [source.last].to_set, event.sources
+        assert_equal [root.last, source.last].to_set, event.all_sources
+    end
+
+    def test_sources_are_kept_with_the_events_if_the_provenance_retention_is_nil
+        execution_engine.provenance_retention = nil
+        plan.add(source = Roby::EventGenerator.new(true))
+        plan.add(target = Roby::EventGenerator.new(true))
+        source.forward_to target
+
+        execute { source.call }
+        event = target.last
+        3.times { execute_one_cycle }
+        assert_equal [source.last].to_set, event.sources
+    end
+
+    def test_error_messages_name_old_sources_with_the_default_provenance_retention
+        assert_nil execution_engine.provenance_retention
+        plan.add_permanent_task(task = Roby::Tasks::Simple.new)
+        plan.add_permanent_event(source = Roby::EventGenerator.new(true))
+        source.forward_to task.stop_event
+        execute { task.start! }
+        execute { source.call }
+        20.times { execute_one_cycle }
+
+        error = task.check_emission_validity(task.start_event)
+        assert_kind_of Roby::EmissionRejected, error
+        assert_includes error.message, "Task has been terminated by #{[source.last]}."
+    end
+
+    def test_provenance_retention_must_be_at_least_one_cycle
+        assert_raises(ArgumentError) do
+            execution_engine.provenance_retention = 0
+        end
+    end
 end
 
 module Roby
@@ -18,6 +18,31 @@
         end
     end
 
+    describe ".framework_backtrace" do
+        after do
+            Roby.framework_backtrace_depth = nil
+        end
+
+        it "returns the caller's backtrace" do
+            assert_equal caller(0).size - 1, Roby.framework_backtrace.size
+        end
+        it "limits the backtrace to framework_backtrace_depth" do
+            Roby.framework_backtrace_depth = 2
+            assert_equal 2, Roby.framework_backtrace.size
+        end
+    end
+
+    describe ".filter_backtrace" do
+        it "reclassifies lines if the filter-out patterns change" do
+            line = "/path/to/custom/file.rb:10:in `method'"
+            assert_equal [line], Roby.filter_backtrace([line], force: true)
+            Roby.app.filter_out_patterns.push(%r{/path/to/custom})
+            assert_equal [], Roby.filter_backtrace([line], force: true)
+        ensure
+            Roby.app.filter_out_patterns.delete(%r{/path/to/custom})
+        end
+    end
+
     describe ".log_exceptions" do
         before do
             Roby.disable_colors
@@ -84,4 +109,38 @@ def stub_exception(text)
             Roby.log_exception(main, logger, :warn)
         end
     end
+
+    describe Roby::ExceptionSnapshot do
+        before do
+            @task = Roby::Task.new
+            @original = ArgumentError.new("original")
+            @original.set_backtrace(["original.rb:1"])
+            @error = Roby::CodeError.new(@original, @task)
+            @error.set_backtrace(["error.rb:1"])
+            @snapshot = Roby::ExceptionSnapshot.capture(@error)
+        end
+
+        it "copies the exception data as frozen strings" do
+            assert_equal "Roby::CodeError", @snapshot.class_name
+            assert_equal @task.to_s, @snapshot.failure_point
+            assert_equal ["error.rb:1"], @snapshot.backtrace
+            assert @snapshot.frozen?
+            assert @snapshot.failure_point.frozen?
+            assert @snapshot.backtrace.frozen?
+        end
+
+        it "captures the original exceptions" do
+            original = @snapshot.original_exceptions.first
+            assert_equal "ArgumentError", original.class_name
+            assert_equal "original", original.message
+            assert_equal ["original.rb:1"], original.backtrace
+        end
+
+        it "is pretty-printed with its class, message and failure point" do
+            assert_equal "ArgumentError: original",
+                         PP.pp(@snapshot.original_exceptions.first, "".dup).chomp
+            assert_equal ["Roby::CodeError", "at #{@task}"],
+                         PP.pp(@snapshot, "".dup, 1).split("\n")
+        end
+    end
 end
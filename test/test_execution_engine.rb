@@ -303,6 +303,51 @@ module Roby
             end
         end
 
+        describe "#clear" do
+            after do
+                execution_engine.reset
+            end
+
+            it "accounts for the teardown in the teardown statistics" do
+                plan.add_mission_task(parent = Tasks::Simple.new)
+                parent.depends_on(child = Tasks::Simple.new)
+                execute { parent.start! }
+
+                execution_engine.quit
+                cycles = 1
+                while execution_engine.clear
+                    execute_one_cycle(garbage_collect: true)
+                    cycles += 1
+                end
+
+                assert plan.tasks.empty?
+                stats = execution_engine.last_teardown_statistics
+                assert_equal 2, stats.task_count
+                assert_equal cycles, stats.cycles
+                assert_equal 1, stats.stop_requests
+                assert_nil execution_engine.teardown_statistics
+            end
+
+            it "tears down a chain of tasks in a number of cycles "\
+               "that does not depend on its length" do
+                cycles = [5, 50].map do |length|
+                    plan.add_mission_task(root = Tasks::Simple.new)
+                    (1..length).inject(root) do |parent, _|
+                        parent.depends_on(child = Tasks::Simple.new)
+                        child
+                    end
+                    execute { root.start! }
+
+                    execution_engine.quit
+                    execute_one_cycle(garbage_collect: true) while execution_engine.clear
+                    assert plan.tasks.empty?
+                    execution_engine.reset
+                    execution_engine.last_teardown_statistics.cycles
+                end
+                assert_equal cycles[0], cycles[1]
+            end
+        end
+
         describe "#garbage_collect" do
             it "stops running tasks" do
                 plan.add(task = Roby::Tasks::Simple.new)
@@ -403,6 +448,43 @@ module Roby
                 can_finalize = true
             end
 
+            it "removes a subtree of pending tasks in a single pass" do
+                plan.add(root = Tasks::Simple.new)
+                tasks = (1..10).inject([root]) do |chain, _|
+                    chain.last.depends_on(child = Tasks::Simple.new)
+                    chain << child
+                end
+                flexmock(plan).should_receive(:unneeded_tasks)
+                              .at_most.twice.pass_thru
+                expect_execution { execution_engine.garbage_collect }
+                    .to { tasks.each { |t| finalize t } }
+            end
+
+            it "removes a subtree of pending tasks as a single batch" do
+                plan.add(root = Tasks::Simple.new)
+                tasks = (1..10).inject([root]) do |chain, _|
+                    chain.last.depends_on(child = Tasks::Simple.new)
+                    chain << child
+                end
+                flexmock(plan).should_receive(:garbage_tasks)
+                              .with(->(batch) { batch.to_set == tasks.to_set })
+                              .once.pass_thru
+                flexmock(plan).should_receive(:garbage_task).never
+                expect_execution { execution_engine.garbage_collect }
+                    .to { tasks.each { |t| finalize t } }
+            end
+
+            it "stops the running children of a removed pending task in the same pass" do
+                plan.add(parent = Tasks::Simple.new)
+                parent.depends_on(child = Tasks::Simple.new)
+                execute { child.start! }
+                expect_execution { execution_engine.garbage_collect }
+                    .to do
+                        finalize parent
+                        emit child.stop_event
+                    end
+            end
+
             it "does garbage-collect tasks passed in the force_gc set, "\
                "regardless of whether they are in the unneeded_tasks set" do
                 plan.add_mission_task(task = Tasks::Simple.new)
@@ -1274,6 +1356,69 @@ def assert_receives_notification(notification_type)
                 end
             end
 
+            describe "exception display" do
+                before do
+                    @error = LocalizedError.new(@task = Task.new).to_execution_exception
+                end
+                after do
+                    execution_engine.flush_exception_display
+                end
+
+                it "formats the exception synchronously by default" do
+                    flexmock(execution_engine)
+                        .should_receive(:display_exception)
+                        .with(:warn, ExecutionEngine::EXCEPTION_FATAL,
+                              @error.exception, [@task])
+                        .once
+                    capture_log(execution_engine, :warn) do
+                        execution_engine.notify_exception(
+                            ExecutionEngine::EXCEPTION_FATAL, @error, [@task]
+                        )
+                    end
+                end
+
+                it "only captures a snapshot in the engine thread and formats it "\
+                   "on the display executor" do
+                    executor = flexmock
+                    execution_engine.exception_display_executor = executor
+                    executor.should_receive(:post).once
+                            .and_return { |*_, &block| @report_writer = block }
+                    flexmock(Roby).should_receive(:log_exception_with_backtrace)
+                                  .pass_thru { @formatted = true }
+                    messages = capture_log(execution_engine, :warn) do
+                        execution_engine.notify_exception(
+                            ExecutionEngine::EXCEPTION_FATAL, @error, [@task]
+                        )
+                    end
+                    assert_equal [], messages
+                    refute @formatted
+                    execution_engine.exception_display_executor = nil
+
+                    messages = capture_log(execution_engine, :warn) do
+                        @report_writer.call
+                    end
+                    assert @formatted
+                    assert_equal "encountered a #{ExecutionEngine::EXCEPTION_FATAL} "\
+                                 "exception", messages.first
+                    assert_equal "  #{@task}", messages.last
+                    assert(messages.any? { |m| m.start_with?("Roby::LocalizedError") },
+                           "#{messages} does not include the exception")
+                end
+
+                it "flushes pending reports when the display is flushed" do
+                    execution_engine.exception_display_executor =
+                        Concurrent::SingleThreadExecutor.new
+                    messages = capture_log(execution_engine, :warn) do
+                        execution_engine.notify_exception(
+                            ExecutionEngine::EXCEPTION_FATAL, @error, [@task]
+                        )
+                        execution_engine.flush_exception_display
+                    end
+                    assert_equal "  #{@task}", messages.last
+                    assert_nil execution_engine.exception_display_executor
+                end
+            end
+
             describe PermanentTaskError do
                 it "adds a PermanentTaskError error if a mission task emits a failure event" do
                     task_m = Task.new_submodel do
@@ -2102,6 +2247,29 @@ def handler(plan)
                 handler.dispose
                 execute_one_cycle
             end
+
+            it "executes the blocks in deadline order" do
+                recorder = flexmock
+                recorder.should_receive(:call).with(1).once.ordered
+                recorder.should_receive(:call).with(2).once.ordered
+                execution_engine.delayed(5) { recorder.call(2) }
+                execution_engine.delayed(3) { recorder.call(1) }
+                execute_one_cycle
+                Timecop.freeze(Time.now + 6)
+                execute_one_cycle
+            end
+
+            it "keeps the blocks whose deadline has not been reached" do
+                recorder = flexmock
+                recorder.should_receive(:call).with(1).once
+                recorder.should_receive(:call).with(2).never
+                execution_engine.delayed(3) { recorder.call(1) }
+                execution_engine.delayed(10) { recorder.call(2) }
+                execute_one_cycle
+                Timecop.freeze(Time.now + 6)
+                execute_one_cycle
+                assert_equal 1, execution_engine.delayed_blocks.size
+            end
         end
     end
 end
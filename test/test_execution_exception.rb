@@ -98,6 +98,48 @@ def create_exception_from(object)
                 expected = Set[[task, t1, nil], [task, t2, nil]]
                 assert_sets_equal expected, e.trace.each_edge.to_set
             end
+
+            it "does not duplicate the propagation prefix shared by the siblings" do
+                task, t1, t2, t3 = prepare_plan add: 4
+                e = create_exception_from(task)
+                e.propagate(task, t1)
+                s = e.fork
+                e.propagate(t1, t2)
+                s.propagate(t1, t3)
+                e.merge(s)
+
+                assert_equal [[task, t1, nil], [t1, t2, nil], [t1, t3, nil]],
+                             e.trace.each_edge.to_a
+                assert_equal [task, t1, t2, t3], e.trace.each_vertex.to_a
+            end
+
+            it "returns the leafs of both siblings" do
+                task, t1, t2 = prepare_plan add: 3
+                e = create_exception_from(task)
+                s = e.fork
+                e.propagate(task, t1)
+                s.propagate(task, t2)
+                e.merge(s)
+                assert_equal [t1, t2], e.propagation_leafs
+            end
+        end
+
+        describe "#propagation_leafs" do
+            it "returns the last task of the propagation" do
+                task, t1, t2 = prepare_plan add: 3
+                e = create_exception_from(task)
+                e.propagate(task, t1)
+                e.propagate(t1, t2)
+                assert_equal [t2], e.propagation_leafs
+            end
+
+            it "handles deep propagation chains" do
+                tasks = prepare_plan add: 10_000
+                e = create_exception_from(tasks.first)
+                tasks.each_cons(2) { |a, b| e.propagate(a, b) }
+                assert_equal [tasks.last], e.propagation_leafs
+                assert_equal tasks, e.each_involved_task.to_a
+            end
         end
 
         describe "#involved_task?" do
@@ -117,6 +159,14 @@ def create_exception_from(object)
                 e = create_exception_from(task)
                 refute e.involved_task?(t1)
             end
+            it "does not see the tasks a sibling propagated to after the fork" do
+                task, t1 = prepare_plan add: 2
+                e = create_exception_from(task)
+                s = e.fork
+                s.propagate(task, t1)
+                refute e.involved_task?(t1)
+                assert s.involved_task?(t1)
+            end
         end
     end
 end
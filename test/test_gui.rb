@@ -13,3 +13,94 @@ def test_index_handling
         end
     end
 end
+
+module Roby
+    module GUI
+        describe RelationsCanvas do
+            before do
+                @app = Qt::Application.instance || Qt::Application.new([])
+                @plan = DRoby::RebuiltPlan.new
+                @canvas = RelationsCanvas.new([@plan])
+                @layout_count = 0
+                flexmock(PlanDotLayout).new_instances do |dot|
+                    dot.should_receive(:layout).and_return { @layout_count += 1 }
+                    dot.should_receive(:apply)
+                end
+                @plan.add(@task = Tasks::Simple.new)
+                @canvas.update(changes: DRoby::PlanChangeSet.full)
+            end
+
+            it "lays out the plans on the first update" do
+                assert_equal 1, @layout_count
+            end
+
+            it "lays out the plans again if the changes are unknown" do
+                @canvas.update
+                assert_equal 2, @layout_count
+            end
+
+            it "does not lay out the plans again if nothing changed" do
+                @canvas.update(changes: DRoby::PlanChangeSet.new)
+                assert_equal 1, @layout_count
+            end
+
+            it "does not lay out the plans again for event propagations" do
+                event = @task.start_event.new([], 0)
+                @plan.propagated_events << [false, [event], @task.stop_event]
+                @canvas.update(changes: DRoby::PlanChangeSet.new)
+                assert_equal 1, @layout_count
+            end
+
+            it "lays out the plans again when a displayed task is added" do
+                @plan.add(task = Tasks::Simple.new)
+                changes = DRoby::PlanChangeSet.new
+                changes.added_objects << task
+                @canvas.update(changes: changes)
+                assert_equal 2, @layout_count
+            end
+
+            it "lays out the plans again when a layout relation changed "\
+               "between displayed tasks" do
+                @plan.add(child = Tasks::Simple.new)
+                @canvas.update(changes: DRoby::PlanChangeSet.full)
+                @task.depends_on child
+                changes = DRoby::PlanChangeSet.new
+                changes.added_edges << [@task, child, TaskStructure::Dependency]
+                @canvas.update(changes: changes)
+                assert_equal 3, @layout_count
+            end
+
+            it "takes a change set into account only once" do
+                @plan.add(child = Tasks::Simple.new)
+                @canvas.update(changes: DRoby::PlanChangeSet.full)
+                @task.depends_on child
+                changes = DRoby::PlanChangeSet.new
+                changes.added_edges << [@task, child, TaskStructure::Dependency]
+                @canvas.update(changes: changes)
+                @canvas.update(changes: changes)
+                assert_equal 3, @layout_count
+            end
+
+            it "lays out the plans again when the label of a changed object "\
+               "changed size" do
+                sizes = Hash.new([10, 10])
+                flexmock(@canvas).should_receive(:label_size)
+                                 .and_return { |obj| sizes[obj] }
+                @canvas.update(changes: DRoby::PlanChangeSet.full)
+                sizes[@task] = [20, 10]
+                changes = DRoby::PlanChangeSet.new
+                changes.changed_objects << @task
+                @canvas.update(changes: changes)
+                assert_equal 3, @layout_count
+            end
+
+            it "does not lay out the plans again when the label of a changed "\
+               "object kept its size" do
+                changes = DRoby::PlanChangeSet.new
+                changes.changed_objects << @task
+                @canvas.update(changes: changes)
+                assert_equal 1, @layout_count
+            end
+        end
+    end
+end
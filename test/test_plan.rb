@@ -471,25 +471,25 @@ module Roby
                 plan.add(parent = EventGenerator.new(true))
                 plan.add_permanent_event(child = EventGenerator.new(true))
                 parent.signals child
-                assert [parent, child].to_set, plan.useful_events.to_set
+                assert_equal [parent, child].to_set, plan.useful_events.to_set
             end
             it "considers events parent of task events as useful" do
                 plan.add(parent = EventGenerator.new(true))
                 plan.add(task = Roby::Task.new)
                 parent.forward_to task.start_event
-                assert [parent].to_set, plan.useful_events.to_set
+                assert_equal [parent].to_set, plan.useful_events.to_set
             end
             it "considers events children of permanent events as useful" do
                 plan.add_permanent_event(parent = EventGenerator.new(true))
                 plan.add(child = EventGenerator.new(true))
                 parent.signals child
-                assert [parent, child].to_set, plan.useful_events.to_set
+                assert_equal [parent, child].to_set, plan.useful_events.to_set
             end
             it "considers events children of task events as useful" do
                 plan.add(child = EventGenerator.new(true))
                 plan.add(task = Roby::Task.new)
                 task.start_event.forward_to child
-                assert [child].to_set, plan.useful_events.to_set
+                assert_equal [child].to_set, plan.useful_events.to_set
             end
             it "considers any event linked to another useful event useful" do
                 plan.add_permanent_event(parent_1 = EventGenerator.new)
@@ -497,7 +497,26 @@ module Roby
                 plan.add(aggregator = EventGenerator.new)
                 parent_1.forward_to aggregator
                 parent_2.forward_to aggregator
-                assert [parent_1, parent_2, aggregator].to_set, plan.useful_events.to_set
+                assert_equal [parent_1, parent_2, aggregator].to_set, plan.useful_events.to_set
+            end
+            it "follows the connections across relations" do
+                plan.add(task = Roby::Task.new)
+                plan.add(a = EventGenerator.new)
+                plan.add(b = EventGenerator.new)
+                plan.add(c = EventGenerator.new)
+                task.start_event.forward_to a
+                b.forward_to a
+                b.signals c
+                assert_equal [a, b, c].to_set, plan.useful_events.to_set
+            end
+            it "does not follow the connections through task events" do
+                plan.add(task = Roby::Task.new)
+                plan.add(a = EventGenerator.new)
+                plan.add(b = EventGenerator.new)
+                plan.add(c = EventGenerator.new)
+                a.forward_to task.start_event
+                b.forward_to c
+                assert_equal [a].to_set, plan.useful_events.to_set
             end
         end
 
@@ -633,6 +652,118 @@ def prepare_mappings(mappings)
             PlanReplaceBehaviors.replace(self)
         end
 
+        describe "#replace_tasks" do
+            before do
+                plan.add(@task = Roby::Task.new)
+                plan.add(@replaced_task = Roby::Task.new)
+                plan.add(@replacing_task = Roby::Task.new)
+            end
+
+            PlanReplaceBehaviors.in_plan_context(self, :replace_task)
+            define_method :perform_replacement do |**options|
+                replacement_plan.replace_tasks(
+                    { @replaced_task => @replacing_task }, **options
+                )
+            end
+            PlanReplaceBehaviors.replace_task(self)
+
+            describe "with multiple tasks" do
+                before do
+                    plan.add(@other_replaced = Roby::Task.new)
+                    plan.add(@other_replacing = Roby::Task.new)
+                end
+
+                def perform_bulk_replacement
+                    plan.replace_tasks(
+                        @replaced_task => @replacing_task,
+                        @other_replaced => @other_replacing
+                    )
+                end
+
+                it "moves the relations of all the replaced tasks" do
+                    @task.depends_on @replaced_task
+                    @other_replaced.depends_on @task
+                    perform_bulk_replacement
+                    assert_equal [@task], @replacing_task.each_parent_task.to_a
+                    assert_equal [@other_replacing], @task.each_parent_task.to_a
+                    assert_equal [@task], @other_replacing.each_child.map(&:first)
+                    assert @replaced_task.root?(TaskStructure::Dependency)
+                    assert @other_replaced.leaf?(TaskStructure::Dependency)
+                end
+
+                it "moves a relation between two replaced tasks "\
+                   "to the two replacing tasks" do
+                    @replaced_task.depends_on @other_replaced
+                    perform_bulk_replacement
+                    assert @replacing_task.depends_on?(@other_replacing)
+                    refute @replaced_task.depends_on?(@other_replaced)
+                    assert_equal [@replacing_task],
+                                 @other_replacing.each_parent_task.to_a
+                end
+
+                it "moves an event relation between two replaced tasks "\
+                   "to the two replacing tasks" do
+                    @replaced_task.stop_event.forward_to @other_replaced.start_event
+                    perform_bulk_replacement
+                    assert @replacing_task.stop_event.child_object?(
+                        @other_replacing.start_event, EventStructure::Forwarding
+                    )
+                    assert @replaced_task.stop_event.leaf?(EventStructure::Forwarding)
+                end
+
+                it "raises ArgumentError if a task is both replaced and replacing" do
+                    assert_raises(ArgumentError) do
+                        plan.replace_tasks(
+                            @replaced_task => @replacing_task,
+                            @replacing_task => @other_replacing
+                        )
+                    end
+                end
+
+                it "does not modify the plan if one of the replacements is invalid" do
+                    @task.depends_on @replaced_task
+                    flexmock(@other_replacing).should_receive(:fullfills?)
+                                              .and_return(false)
+                    assert_raises(InvalidReplace) { perform_bulk_replacement }
+                    assert @task.depends_on?(@replaced_task)
+                    refute @task.depends_on?(@replacing_task)
+                end
+
+                it "does not add replacing tasks from a template plan "\
+                   "if a later pair is invalid" do
+                    new_task = Roby::Task.new
+                    flexmock(@other_replacing).should_receive(:fullfills?)
+                                              .and_return(false)
+                    assert_raises(InvalidReplace) do
+                        plan.replace_tasks(
+                            @replaced_task => new_task,
+                            @other_replaced => @other_replacing
+                        )
+                    end
+                    refute plan.has_task?(new_task)
+                end
+
+                it "does not add replacing tasks from a template plan "\
+                   "if a task is both replaced and replacing" do
+                    new_task = Roby::Task.new
+                    assert_raises(ArgumentError) do
+                        plan.replace_tasks(
+                            @replaced_task => new_task,
+                            @replacing_task => @other_replacing,
+                            @other_replaced => @replacing_task
+                        )
+                    end
+                    refute plan.has_task?(new_task)
+                end
+
+                it "adds replacing tasks from a template plan" do
+                    new_task = Roby::Task.new
+                    plan.replace_tasks(@replaced_task => new_task)
+                    assert plan.has_task?(new_task)
+                end
+            end
+        end
+
         describe "#in_useful_subplan?" do
             before do
                 @reference_task = Roby::Task.new
@@ -855,6 +986,26 @@ def prepare_mappings(mappings)
             end
         end
 
+        describe "#remove_tasks" do
+            before do
+                plan.add(@tasks = [Roby::Task.new, Roby::Task.new])
+            end
+            it "removes all the tasks with the same timestamp" do
+                timestamp = Time.at(2)
+                @tasks.each do |t|
+                    flexmock(plan).should_receive(:remove_task!).with(t, timestamp).once
+                end
+                plan.remove_tasks(@tasks, timestamp)
+            end
+            it "does not modify the plan if one of the tasks cannot be removed" do
+                other = Roby::Task.new
+                assert_raises(ArgumentError) do
+                    plan.remove_tasks(@tasks + [other])
+                end
+                assert(@tasks.all? { |t| plan.has_task?(t) })
+            end
+        end
+
         describe "#remove_task!" do
             before do
                 plan.add(@task = Roby::Task.new)
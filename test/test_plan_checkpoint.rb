@@ -0,0 +1,167 @@
+# frozen_string_literal: true
+
+require "roby/test/self"
+
+module PlanCheckpointTest
+    class RefusingTask < Roby::Tasks::Simple
+        def restore_from_checkpoint(running: false)
+            false
+        end
+    end
+
+    class ReattachingTask < Roby::Tasks::Simple
+        attr_reader :restored_running
+
+        def restore_from_checkpoint(running: false)
+            @restored_running = running
+            true
+        end
+    end
+end
+
+module Roby
+    describe PlanCheckpoint do
+        def roundtrip(checkpoint)
+            path = File.join(make_tmpdir, "checkpoint")
+            checkpoint.save(path)
+            PlanCheckpoint.load(path)
+        end
+
+        def restore(checkpoint)
+            execute { roundtrip(checkpoint).restore(plan) }
+        end
+
+        describe ".capture" do
+            it "records the tasks that are not finished" do
+                plan.add(pending = Tasks::Simple.new)
+                plan.add(running = Tasks::Simple.new)
+                plan.add_permanent_task(finished = Tasks::Simple.new)
+                execute do
+                    running.start!
+                    finished.start!
+                    finished.success_event.emit
+                end
+
+                checkpoint = PlanCheckpoint.capture(plan)
+                assert_equal %i[pending running],
+                             checkpoint.tasks.map(&:state).sort
+            end
+
+            it "records the planning tasks of the recorded tasks" do
+                plan.add_mission_task(task = Tasks::Simple.new)
+                task.planned_by(planner = Tasks::Simple.new)
+                execute do
+                    planner.start!
+                    planner.success_event.emit
+                end
+
+                checkpoint = PlanCheckpoint.capture(plan)
+                assert_equal %i[pending success],
+                             checkpoint.tasks.map(&:state).sort
+            end
+        end
+
+        describe "#restore" do
+            it "creates new pending tasks with the same models and arguments" do
+                plan.add_mission_task(task = Tasks::Simple.new(id: "test"))
+                execute { task.start! }
+
+                checkpoint = PlanCheckpoint.capture(plan)
+                restored, = restore(checkpoint)
+                refute_same task, restored
+                assert_kind_of Tasks::Simple, restored
+                assert_equal "test", restored.arguments[:id]
+                assert restored.pending?
+                assert plan.mission_task?(restored)
+            end
+
+            it "restores the task relations" do
+                plan.add_mission_task(parent = Tasks::Simple.new)
+                parent.depends_on(child = Tasks::Simple.new, role: "test")
+
+                checkpoint = PlanCheckpoint.capture(plan)
+                r_parent, r_child = restore(checkpoint)
+                assert r_parent.depends_on?(r_child)
+                assert_equal r_child, r_parent.child_from_role("test")
+            end
+
+            it "restores finished planning tasks as finished" do
+                plan.add_mission_task(task = Tasks::Simple.new)
+                task.planned_by(planner = Tasks::Simple.new)
+                execute do
+                    planner.start!
+                    planner.success_event.emit
+                end
+
+                checkpoint = PlanCheckpoint.capture(plan)
+                r_task, r_planner = restore(checkpoint)
+                assert_equal r_planner, r_task.planning_task
+                assert r_planner.finished?
+                assert r_planner.success?
+            end
+
+            it "restores the event history of finished planning tasks" do
+                plan.add_mission_task(task = Tasks::Simple.new)
+                task.planned_by(planner = Tasks::Simple.new)
+                execute do
+                    planner.start!
+                    planner.success_event.emit(42)
+                end
+
+                checkpoint = PlanCheckpoint.capture(plan)
+                _, r_planner = restore(checkpoint)
+                assert_equal %i[start success stop],
+                             r_planner.history.map(&:symbol)
+                assert r_planner.success_event.emitted?
+                assert_equal [42], r_planner.success_event.last.context
+                assert_equal planner.success_event.last.time,
+                             r_planner.success_event.last.time
+                assert_equal r_planner.success_event.last,
+                             r_planner.terminal_event
+            end
+
+            it "lets the tasks know whether they were running" do
+                plan.add(pending = PlanCheckpointTest::ReattachingTask.new)
+                plan.add(running = PlanCheckpointTest::ReattachingTask.new)
+                execute { running.start! }
+
+                checkpoint = PlanCheckpoint.capture(plan)
+                restored = restore(checkpoint)
+                assert_equal [false, true],
+                             restored.map(&:restored_running).sort_by { |v| v ? 1 : 0 }
+            end
+
+            it "does not modify the plan if a task refuses to be restored" do
+                plan.add(Tasks::Simple.new)
+                plan.add(PlanCheckpointTest::RefusingTask.new)
+
+                checkpoint = roundtrip(PlanCheckpoint.capture(plan))
+                tasks = plan.tasks.dup
+                assert_raises(PlanCheckpoint::RestoreFailed) do
+                    execute { checkpoint.restore(plan) }
+                end
+                assert_equal tasks, plan.tasks
+            end
+
+            it "fails if a task model cannot be resolved" do
+                task_m = Tasks::Simple.new_submodel
+                plan.add(task_m.new)
+
+                checkpoint = roundtrip(PlanCheckpoint.capture(plan))
+                assert_raises(PlanCheckpoint::RestoreFailed) do
+                    execute { checkpoint.restore(plan) }
+                end
+            end
+        end
+
+        describe ".load" do
+            it "raises if the file has an unexpected version" do
+                path = File.join(make_tmpdir, "checkpoint")
+                File.open(path, "wb") { |io| ::Marshal.dump([0, Time.now, [], []], io) }
+                assert_raises(PlanCheckpoint::InvalidFormat) do
+                    PlanCheckpoint.load(path)
+                end
+            end
+        end
+    end
+end
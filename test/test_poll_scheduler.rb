@@ -0,0 +1,91 @@
+# frozen_string_literal: true
+
+require "roby/test/self"
+
+module Roby
+    describe PollScheduler do
+        attr_reader :engine, :scheduler
+
+        before do
+            @now = Time.at(1000)
+            @engine = flexmock(cycle_length: 0.1, plan: plan)
+            @engine.should_receive(:cycle_start).and_return { @now }
+            @scheduler = PollScheduler.new(@engine, random: flexmock(rand: 0.5))
+        end
+
+        it "calls the blocks without a period at each call" do
+            calls = []
+            scheduler.add { |p| calls << p }
+            scheduler.call
+            scheduler.call
+            assert_equal [plan, plan], calls
+        end
+
+        it "calls periodic blocks starting at a random point within their period" do
+            calls = 0
+            scheduler.add(10) { calls += 1 }
+            @now += 4.9
+            scheduler.call
+            assert_equal 0, calls
+            @now += 0.1
+            scheduler.call
+            assert_equal 1, calls
+        end
+
+        it "reschedules periodic blocks after their period" do
+            calls = 0
+            scheduler.add(10) { calls += 1 }
+            @now += 5
+            scheduler.call
+            @now += 9.9
+            scheduler.call
+            assert_equal 1, calls
+            @now += 0.1
+            scheduler.call
+            assert_equal 2, calls
+        end
+
+        it "keeps the blocks' phase if they are late" do
+            calls = 0
+            scheduler.add(10) { calls += 1 }
+            @now += 37
+            scheduler.call
+            assert_equal 1, calls
+            assert_equal Time.at(1045), scheduler.scheduled.first[0]
+        end
+
+        it "does not call disposed blocks" do
+            calls = 0
+            scheduler.add { calls += 1 }.dispose
+            scheduler.add(1) { calls += 1 }.dispose
+            @now += 1
+            scheduler.call
+            assert_equal 0, calls
+            assert scheduler.every_cycle.empty?
+            assert scheduler.scheduled.empty?
+        end
+
+        it "reports the poll work done in the last call" do
+            scheduler.add {}
+            scheduler.add(10) {}
+            scheduler.add(1) {}
+            @now += 1
+            report = scheduler.call
+            assert_same report, scheduler.last_report
+            assert_equal 2, report.polled
+            assert_equal 2, report.pending
+        end
+
+        it "registers exceptions raised by the blocks as framework errors" do
+            error = Class.new(RuntimeError).new
+            scheduler.add { raise error }
+            engine.should_receive(:add_framework_error).with(error, "task poll").once
+            scheduler.call
+        end
+
+        it "rejects non-positive periods" do
+            assert_raises(ArgumentError) { scheduler.add(0) {} }
+            assert_raises(ArgumentError) { scheduler.add(-1) {} }
+        end
+    end
+end
@@ -680,6 +680,34 @@ def self.common_instanciate_model_event_relations_behaviour
             end
         end
 
+        describe "event initialization" do
+            it "creates one generator per model event" do
+                task_m = Roby::Task.new_submodel { event :ev1 }
+                task = task_m.new
+                assert_equal task_m.each_event.map(&:first).sort,
+                             task.bound_events.keys.sort
+                task.each_event do |ev|
+                    assert_same task_m.event_model(ev.symbol), ev.event_model
+                end
+            end
+
+            it "creates the events defined after the model has been instanciated" do
+                task_m = Roby::Task.new_submodel
+                task_m.new
+                task_m.event :ev1
+                assert task_m.new.find_event(:ev1)
+            end
+
+            it "creates the events defined on a parent model after a submodel "\
+               "has been instanciated" do
+                task_m = Roby::Task.new_submodel
+                subtask_m = task_m.new_submodel
+                subtask_m.new
+                task_m.event :ev1
+                assert subtask_m.new.find_event(:ev1)
+            end
+        end
+
         describe "#execute" do
             let(:recorder) { flexmock }
 
@@ -1012,6 +1040,69 @@ def replace(task0, task1)
                 assert(!task.running?)
                 assert(task.finished?)
             end
+
+            describe "with a period" do
+                before do
+                    execution_engine.poll_scheduler.random = flexmock(rand: 0)
+                end
+
+                it "calls an instance block at the given period" do
+                    poll_count = 0
+                    plan.add_permanent_task(task = task_m.new)
+                    task.poll(period: 100) { poll_count += 1 }
+                    execute { task.start! }
+                    execute_one_cycle
+                    execute_one_cycle
+                    assert_equal 1, poll_count
+                end
+
+                it "calls the model block at the model's period" do
+                    model_count = 0
+                    instance_count = 0
+                    task_m.poll(period: 100) { model_count += 1 }
+                    plan.add_permanent_task(task = task_m.new)
+                    task.poll { instance_count += 1 }
+                    execute { task.start! }
+                    execute_one_cycle
+                    execute_one_cycle
+                    assert_equal 1, model_count
+                    assert_equal 3, instance_count
+                end
+
+                it "inherits the model's period in submodels" do
+                    task_m.poll(period: 100) {}
+                    assert_equal 100, task_m.new_submodel.poll_period
+                end
+
+                it "lets a submodel poll at every cycle again" do
+                    task_m.poll(period: 100) {}
+                    submodel = task_m.new_submodel { poll {} }
+                    assert_nil submodel.poll_period
+                end
+
+                it "stops polling when the task stops" do
+                    poll_count = 0
+                    plan.add(task = task_m.new)
+                    task.poll(period: 100) { poll_count += 1 }
+                    execute { task.start! }
+                    execute { task.stop! }
+                    poll_count = 0
+                    execution_engine.poll_scheduler.scheduled.first[0] = Time.at(0)
+                    execute_one_cycle
+                    assert_equal 0, poll_count
+                end
+
+                it "rejects non-positive periods" do
+                    plan.add(task = task_m.new)
+                    assert_raises(ArgumentError) { task.poll(period: 0) {} }
+                end
+            end
+
+            it "does not register tasks that have nothing to poll" do
+                plan.add(task = Tasks::Simple.new)
+                execute { task.start! }
+                assert execution_engine.poll_scheduler.empty?
+            end
         end
 
         describe "#achieve_with" do
@@ -1444,6 +1535,44 @@ def self.nominal_behaviour(context)
                 plan.add(task = task_m.new)
                 refute task.handle_exception(localized_error_m.new(task).to_execution_exception)
             end
+
+            it "does not test handlers whose exception model cannot match" do
+                other_error_m = Class.new(LocalizedError)
+                matcher = other_error_m.to_execution_exception_matcher
+                flexmock(matcher).should_receive(:===).never
+                task_m.on_exception(matcher) {}
+                plan.add(task = task_m.new)
+                refute task.handle_exception(localized_error_m.new(task).to_execution_exception)
+            end
+
+            it "keeps the handler order across exception models" do
+                recorder = flexmock
+                task_m.on_exception(LocalizedError) do |exception|
+                    recorder.called(2)
+                end
+                task_m.on_exception(Class.new(LocalizedError)) do |exception|
+                    recorder.called(:other)
+                end
+                task_m.on_exception(localized_error_m) do |exception|
+                    recorder.called(1)
+                    pass_exception
+                end
+                plan.add(task = task_m.new)
+                recorder.should_receive(:called).with(1).once.ordered
+                recorder.should_receive(:called).with(2).once.ordered
+                assert task.handle_exception(localized_error_m.new(task).to_execution_exception)
+            end
+
+            it "considers handlers added to a parent model after a first lookup" do
+                submodel_m = task_m.new_submodel
+                plan.add(task = submodel_m.new)
+                refute task.handle_exception(localized_error_m.new(task).to_execution_exception)
+
+                recorder = flexmock
+                recorder.should_receive(:called).once
+                task_m.on_exception(localized_error_m) { |_| recorder.called }
+                assert task.handle_exception(localized_error_m.new(task).to_execution_exception)
+            end
         end
 
         describe "#promise" do